@@ -2,25 +2,255 @@
 
 #include <ostream>
 #include <iostream>
-#include <deque>
-#include <execution>
+#include <vector>
 #include <algorithm>
 #include <climits>
 #include <cassert>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <functional>
+#include <unordered_map>
 #include <cmath>
 #include <iterator>
+#include <limits>
+#include <initializer_list>
+#include <array>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <deque>
+#include <mutex>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <numeric>
+#include <istream>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ *  Number of limbs a value keeps inside the object before spilling to the heap.
+ *  The default covers every value below 2^128.
+ */
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 2
+#endif
 
 namespace
 {
 
 using Bit = bool;
-using BinaryData = std::deque<Bit>;
-using BinaryReturnType = std::tuple<BinaryData, size_t>;
+using Limb = uint64_t;
+using DoubleLimb = unsigned __int128;
+
+constexpr const size_t LimbBits = std::numeric_limits<Limb>::digits;
+constexpr const size_t LimbBytes = sizeof(Limb);
+constexpr const bool LittleEndianHost = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+/**
+ *  LimbStorage is a vector of limbs with small-buffer optimisation:
+ *  up to InlineCapacity limbs live inside the object, longer numbers spill to the heap.
+ */
+template<size_t InlineCapacity>
+class LimbStorage
+{
+    static_assert(InlineCapacity > 0, "inline capacity must hold at least one limb");
+
+public:
+    using value_type = Limb;
+    using size_type = size_t;
+    using reference = Limb&;
+    using const_reference = const Limb&;
+    using iterator = Limb*;
+    using const_iterator = const Limb*;
+
+    LimbStorage() noexcept :
+        m_data{m_inline},
+        m_size{0},
+        m_capacity{InlineCapacity}
+    {}
+
+    explicit LimbStorage(size_t size, Limb value = 0) :
+        LimbStorage()
+    {
+        resize(size, value);
+    }
+
+    LimbStorage(std::initializer_list<Limb> limbs) :
+        LimbStorage()
+    {
+        assign(limbs.begin(), limbs.end());
+    }
+
+    LimbStorage(const Limb* first, const Limb* last) :
+        LimbStorage()
+    {
+        assign(first, last);
+    }
+
+    LimbStorage(const LimbStorage& other) :
+        LimbStorage()
+    {
+        assign(other.begin(), other.end());
+    }
+
+    LimbStorage(LimbStorage&& other) noexcept :
+        LimbStorage()
+    {
+        steal(other);
+    }
+
+    LimbStorage& operator = (const LimbStorage& other)
+    {
+        if(this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+
+    LimbStorage& operator = (LimbStorage&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~LimbStorage() { release(); }
+
+    inline size_t size() const noexcept { return m_size; }
+    inline bool empty() const noexcept { return m_size == 0; }
+    inline size_t capacity() const noexcept { return m_capacity; }
+    inline bool isInline() const noexcept { return m_data == m_inline; }
+
+    inline Limb* data() noexcept { return m_data; }
+    inline const Limb* data() const noexcept { return m_data; }
+    inline iterator begin() noexcept { return m_data; }
+    inline iterator end() noexcept { return m_data + m_size; }
+    inline const_iterator begin() const noexcept { return m_data; }
+    inline const_iterator end() const noexcept { return m_data + m_size; }
+    inline const_iterator cbegin() const noexcept { return m_data; }
+    inline const_iterator cend() const noexcept { return m_data + m_size; }
+
+    inline Limb& operator[](size_t index) noexcept { return m_data[index]; }
+    inline const Limb& operator[](size_t index) const noexcept { return m_data[index]; }
+    inline Limb& front() noexcept { return m_data[0]; }
+    inline const Limb& front() const noexcept { return m_data[0]; }
+    inline Limb& back() noexcept { return m_data[m_size - 1]; }
+    inline const Limb& back() const noexcept { return m_data[m_size - 1]; }
+
+    void reserve(size_t capacity)
+    {
+        if(capacity <= m_capacity) return;
+        Limb* data = new Limb[capacity];
+        std::copy(m_data, m_data + m_size, data);
+        release();
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    void resize(size_t size, Limb value = 0)
+    {
+        reserve(size);
+        if(size > m_size) std::fill(m_data + m_size, m_data + size, value);
+        m_size = size;
+    }
+
+    void push_back(Limb limb)
+    {
+        if(m_size == m_capacity) reserve(m_capacity * 2);
+        m_data[m_size++] = limb;
+    }
+
+    inline void pop_back() noexcept { --m_size; }
+    inline void clear() noexcept { m_size = 0; }
+
+    void assign(const Limb* first, const Limb* last)
+    {
+        const size_t size = static_cast<size_t>(last - first);
+        m_size = 0;
+        reserve(size);
+        std::copy(first, last, m_data);
+        m_size = size;
+    }
+
+    void swap(LimbStorage& other) noexcept
+    {
+        LimbStorage tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    Limb* m_data;
+    size_t m_size;
+    size_t m_capacity;
+    Limb m_inline[InlineCapacity];
+
+    void release() noexcept
+    {
+        if(!isInline()) delete[] m_data;
+        m_data = m_inline;
+        m_capacity = InlineCapacity;
+    }
+
+    void steal(LimbStorage& other) noexcept
+    {
+        if(other.isInline())
+        {
+            std::copy(other.m_inline, other.m_inline + other.m_size, m_inline);
+            m_data = m_inline;
+            m_capacity = InlineCapacity;
+        }
+        else
+        {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            other.m_data = other.m_inline;
+            other.m_capacity = InlineCapacity;
+        }
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+};
+
+using BinaryData = LimbStorage<BIGINT_INLINE_LIMBS>;
+
+/**
+ *  Read-only limbs owned elsewhere, a BinaryData or memory such as a mapped archive.
+ *  Kernels that only read a magnitude take a LimbSpan so they serve both.
+ */
+class LimbSpan
+{
+public:
+    LimbSpan(const Limb* data, size_t size) noexcept :
+        m_data{data},
+        m_size{size}
+    {}
+
+    LimbSpan(const BinaryData& number) noexcept :
+        LimbSpan(number.data(), number.size())
+    {}
+
+    inline size_t size() const noexcept { return m_size; }
+    inline const Limb* data() const noexcept { return m_data; }
+    inline const Limb* begin() const noexcept { return m_data; }
+    inline const Limb* end() const noexcept { return m_data + m_size; }
+    inline const Limb* cbegin() const noexcept { return m_data; }
+    inline const Limb* cend() const noexcept { return m_data + m_size; }
+    inline const Limb& operator[](size_t index) const noexcept { return m_data[index]; }
+    inline const Limb& front() const noexcept { return m_data[0]; }
+    inline const Limb& back() const noexcept { return m_data[m_size - 1]; }
 
-template<class Iterator>
-using ReturnType = std::tuple<BinaryData, Iterator, bool>;
+private:
+    const Limb* m_data;
+    size_t m_size;
+};
 
 enum class Sign : bool
 {
@@ -28,22 +258,39 @@ enum class Sign : bool
     Negative
 };
 
+enum class Endian : bool
+{
+    Little,
+    Big
+};
+
+enum class Signedness : bool
+{
+    Unsigned,
+    Signed
+};
+
+/**
+ *  State keeps the magnitude as little-endian 64-bit limbs.
+ *  The magnitude is always normalized: no high zero limbs, zero is a single 0 limb
+ *  and zero is never negative.
+ */
 struct State
 {
-    State(const BinaryData& number, size_t bits = 0, Sign sign = Sign::Positive) :
-        number{number},
-        bitSet{bits},
+    State(BinaryData number, Sign sign = Sign::Positive) :
+        number{std::move(number)},
         sign{sign}
-    {}
+    {
+        if(this->number.size() == 1 && this->number[0] == 0)
+            this->sign = Sign::Positive;
+    }
 
     State() :
         number{0},
-        bitSet{0},
         sign{Sign::Positive}
     {}
 
     BinaryData number;
-    std::size_t bitSet;
     Sign sign;
 };
 
@@ -89,1668 +336,5623 @@ constexpr bool is_unsigned()
 namespace Operation
 {
 
-std::unordered_map<char, std::function<Bit(const Bit&, const Bit&)>> predicates
+std::unordered_map<char, std::function<Limb(const Limb&, const Limb&)>> predicates
 {
-    { '^', [](const Bit& lhsBit, const Bit& rhsBit) { return lhsBit == rhsBit ?      0 : 1; } },
-    { '|', [](const Bit& lhsBit, const Bit& rhsBit) { return lhsBit == rhsBit ? lhsBit : 1; } },
-    { '&', [](const Bit& lhsBit, const Bit& rhsBit) { return lhsBit == rhsBit ? lhsBit : 0; } },
+    { '^', [](const Limb& lhsLimb, const Limb& rhsLimb) { return lhsLimb ^ rhsLimb; } },
+    { '|', [](const Limb& lhsLimb, const Limb& rhsLimb) { return lhsLimb | rhsLimb; } },
+    { '&', [](const Limb& lhsLimb, const Limb& rhsLimb) { return lhsLimb & rhsLimb; } },
 };
 
-void leftShift(BinaryData& data, size_t loops = 1) noexcept
+inline size_t countLeadingZeros(Limb limb) noexcept
+{
+    return limb == 0 ? LimbBits : static_cast<size_t>(__builtin_clzll(limb));
+}
+
+inline size_t countTrailingZeros(Limb limb) noexcept
+{
+    return limb == 0 ? LimbBits : static_cast<size_t>(__builtin_ctzll(limb));
+}
+
+inline Limb addWithCarry(Limb lhs, Limb rhs, Limb& carry) noexcept
+{
+    DoubleLimb sum = static_cast<DoubleLimb>(lhs) + rhs + carry;
+    carry = static_cast<Limb>(sum >> LimbBits);
+    return static_cast<Limb>(sum);
+}
+
+inline Limb subWithBorrow(Limb lhs, Limb rhs, Limb& borrow) noexcept
+{
+    DoubleLimb diff = static_cast<DoubleLimb>(lhs) - rhs - borrow;
+    borrow = static_cast<Limb>(diff >> LimbBits) & 1;
+    return static_cast<Limb>(diff);
+}
+
+/**
+ *  Low level kernels over raw limb arrays.
+ *  Output may alias the first input, lhsSize must be >= rhsSize.
+ */
+inline Limb addLimbs(Limb* result, const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) noexcept
+{
+    Limb carry = 0;
+    size_t i{0};
+    for(; i < rhsSize; ++i)
+        result[i] = addWithCarry(lhs[i], rhs[i], carry);
+    for(; i < lhsSize; ++i)
+        result[i] = addWithCarry(lhs[i], 0, carry);
+    return carry;
+}
+
+inline Limb subLimbs(Limb* result, const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) noexcept
 {
-    if(data.empty())
+    Limb borrow = 0;
+    size_t i{0};
+    for(; i < rhsSize; ++i)
+        result[i] = subWithBorrow(lhs[i], rhs[i], borrow);
+    for(; i < lhsSize; ++i)
+        result[i] = subWithBorrow(lhs[i], 0, borrow);
+    return borrow;
+}
+
+// result[0..size) += number[0..size) * multiplier, returns the carry limb
+inline Limb addMulLimb(Limb* result, const Limb* number, size_t size, Limb multiplier) noexcept
+{
+    Limb carry = 0;
+    for(size_t i{0}; i < size; ++i)
     {
-        data.push_back(1);
-        --loops;
+        DoubleLimb product = static_cast<DoubleLimb>(number[i]) * multiplier + result[i] + carry;
+        result[i] = static_cast<Limb>(product);
+        carry = static_cast<Limb>(product >> LimbBits);
     }
-    for(size_t i{0}; i < loops; ++i)
+    return carry;
+}
+
+// result[0..lhsSize+rhsSize) = lhs * rhs, result must not alias the inputs
+inline void mulSchoolbook(Limb* result, const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) noexcept
+{
+    std::fill(result, result + lhsSize + rhsSize, 0);
+    for(size_t i{0}; i < rhsSize; ++i)
+        result[i + lhsSize] = addMulLimb(result + i, lhs, lhsSize, rhs[i]);
+}
+
+// result[0..resultSize) += number[0..size), carry stops as soon as it is absorbed
+inline Limb addAt(Limb* result, size_t resultSize, const Limb* number, size_t size) noexcept
+{
+    Limb carry = 0;
+    size_t i{0};
+    for(; i < size; ++i)
+        result[i] = addWithCarry(result[i], number[i], carry);
+    for(; carry != 0 && i < resultSize; ++i)
+        result[i] = addWithCarry(result[i], 0, carry);
+    return carry;
+}
+
+// result[0..resultSize) -= number[0..size), borrow stops as soon as it is absorbed
+inline Limb subAt(Limb* result, size_t resultSize, const Limb* number, size_t size) noexcept
+{
+    Limb borrow = 0;
+    size_t i{0};
+    for(; i < size; ++i)
+        result[i] = subWithBorrow(result[i], number[i], borrow);
+    for(; borrow != 0 && i < resultSize; ++i)
+        result[i] = subWithBorrow(result[i], 0, borrow);
+    return borrow;
+}
+
+// quotient[0..size) = number / divisor, returns the remainder; quotient may alias number
+inline Limb divRemLimb(Limb* quotient, const Limb* number, size_t size, Limb divisor) noexcept
+{
+    DoubleLimb remainder = 0;
+    for(size_t i = size; i-- > 0;)
     {
-        if(data.size() == std::numeric_limits<size_t>::max()) break;
-        data.push_back(0);
+        DoubleLimb current = (remainder << LimbBits) | number[i];
+        quotient[i] = static_cast<Limb>(current / divisor);
+        remainder = current % divisor;
     }
+    return static_cast<Limb>(remainder);
 }
 
-void rightShift(BinaryData& data, size_t& units, size_t loops)
+// remainder of number[0..size) / divisor
+inline Limb modLimb(const Limb* number, size_t size, Limb divisor) noexcept
 {
-    for(size_t i{0}; i < loops; ++i)
+    DoubleLimb remainder = 0;
+    for(size_t i = size; i-- > 0;)
+        remainder = ((remainder << LimbBits) | number[i]) % divisor;
+    return static_cast<Limb>(remainder);
+}
+
+// result[0..size) = number * multiplier, returns the carry limb; result may alias number
+inline Limb mulLimb(Limb* result, const Limb* number, size_t size, Limb multiplier) noexcept
+{
+    Limb carry = 0;
+    for(size_t i{0}; i < size; ++i)
     {
-        Bit& bit = data.back();
-        if(data.size() == 1)
-        {
-            if(bit == 1)
-            {
-                bit = 0;
-                --units;
-                break;
-            }
-        }
-        else
-        {
-            if(bit == 1) --units;
-            data.pop_back();
-        }
+        const DoubleLimb product = static_cast<DoubleLimb>(number[i]) * multiplier + carry;
+        result[i] = static_cast<Limb>(product);
+        carry = static_cast<Limb>(product >> LimbBits);
     }
+    return carry;
 }
 
-void rightShift(BinaryData& data, size_t loops = 1)
+inline size_t significantSize(const Limb* number, size_t size) noexcept
+{
+    while(size > 0 && number[size - 1] == 0) --size;
+    return size;
+}
+
+// result[0..2*size) = number^2, every cross product is computed once and doubled
+inline void sqrSchoolbook(Limb* result, const Limb* number, size_t size) noexcept
 {
-    for(size_t i{0}; i < loops; ++i)
+    std::fill(result, result + 2 * size, 0);
+    for(size_t i{0}; i + 1 < size; ++i)
+        result[i + size] = addMulLimb(result + 2 * i + 1, number + i + 1, size - i - 1, number[i]);
+
+    Limb shifted = 0;
+    for(size_t i{0}; i < 2 * size; ++i)
     {
-        Bit& bit = data.back();
-        if(data.size() == 1)
-        {
-            if(bit == 1)
-            {
-                bit = 0;
-                break;
-            }
-        }
-        else data.pop_back();
+        const Limb limb = result[i];
+        result[i] = (limb << 1) | shifted;
+        shifted = limb >> (LimbBits - 1);
+    }
+
+    Limb carry = 0;
+    for(size_t i{0}; i < size; ++i)
+    {
+        const DoubleLimb square = static_cast<DoubleLimb>(number[i]) * number[i];
+        result[2 * i] = addWithCarry(result[2 * i], static_cast<Limb>(square), carry);
+        result[2 * i + 1] = addWithCarry(result[2 * i + 1], static_cast<Limb>(square >> LimbBits), carry);
     }
 }
 
 void removeInsignificantBits(BinaryData& number)
 {
-    while(true)
-    {
-        auto it = begin(number);
-        if(*it == 1 || number.size() == 1) break;
-        if(*it == 0) number.pop_front();
-    }
+    while(number.size() > 1 && number.back() == 0)
+        number.pop_back();
+
+    if(number.empty()) number.push_back(0);
+}
+
+inline bool isZero(LimbSpan number) noexcept
+{
+    return number.size() == 1 && number[0] == 0;
+}
+
+size_t bitLength(LimbSpan number) noexcept
+{
+    size_t length = (number.size() - 1) * LimbBits + (LimbBits - countLeadingZeros(number.back()));
+    return std::max(static_cast<size_t>(1), length);
+}
+
+size_t popCount(LimbSpan number) noexcept
+{
+    size_t units{0};
+    for(const Limb& limb : number)
+        units += static_cast<size_t>(__builtin_popcountll(limb));
+    return units;
+}
+
+inline Bit testBit(LimbSpan number, size_t index) noexcept
+{
+    return index / LimbBits < number.size() && ((number[index / LimbBits] >> (index % LimbBits)) & 1);
 }
 
-void Increment(BinaryData& data, size_t& units)
+void leftShift(BinaryData& data, size_t loops = 1)
 {
-    for(auto it = data.rbegin(); it != data.rend(); ++it)
+    if(loops == 0 || isZero(data)) return;
+
+    const size_t limbs = loops / LimbBits;
+    const size_t bits = loops % LimbBits;
+    const size_t oldSize = data.size();
+    const Limb carry = bits == 0 ? 0 : data.back() >> (LimbBits - bits);
+    data.resize(oldSize + limbs + (carry != 0 ? 1 : 0), 0);
+
+    if(bits == 0)
     {
-        if(*it == 0)
-        {
-            *it = 1;
-            ++units;
-            break;
-        }
-        *it = 0;
-        --units;
+        for(size_t i = oldSize; i-- > 0;)
+            data[i + limbs] = data[i];
     }
-
-    if(*data.begin() == 0)
+    else
     {
-        data.push_front(1);
-        ++units;
+        if(carry != 0) data[oldSize + limbs] = carry;
+        for(size_t i = oldSize - 1; i > 0; --i)
+            data[i + limbs] = (data[i] << bits) | (data[i - 1] >> (LimbBits - bits));
+        data[limbs] = data[0] << bits;
     }
+
+    std::fill(data.begin(), std::next(data.begin(), limbs), 0);
 }
 
-void Decrement(BinaryData& data, size_t& units)
+void rightShift(BinaryData& data, size_t loops = 1)
 {
-    for(auto it = data.rbegin(); it != data.rend(); ++it)
+    const size_t limbs = loops / LimbBits;
+    const size_t bits = loops % LimbBits;
+    if(limbs >= data.size())
     {
-        if(*it == 1)
-        {
-            *it = 0;
-            --units;
-            break;
-        }
-        *it = 1;
-        ++units;
+        data.clear();
+        data.push_back(0);
+        return;
+    }
+
+    const size_t newSize = data.size() - limbs;
+    if(bits == 0)
+    {
+        for(size_t i{0}; i < newSize; ++i)
+            data[i] = data[i + limbs];
+    }
+    else
+    {
+        for(size_t i{0}; i + 1 < newSize; ++i)
+            data[i] = (data[i + limbs] >> bits) | (data[i + limbs + 1] << (LimbBits - bits));
+        data[newSize - 1] = data[newSize - 1 + limbs] >> bits;
     }
 
+    data.resize(newSize);
     removeInsignificantBits(data);
 }
 
-template<class Iterator>
-constexpr void isRandomAccessIterator()
+void Increment(BinaryData& data)
 {
-    static_assert (std::is_same_v<typename std::iterator_traits<Iterator>::iterator_category,
-                std::random_access_iterator_tag>, "Iterator should be random access iterator");
+    for(Limb& limb : data)
+        if(++limb != 0) return;
+
+    data.push_back(1);
 }
 
-struct Less
+void Decrement(BinaryData& data)
 {
-    bool operator()(const BinaryData& lhs, const BinaryData& rhs)
+    assert(!isZero(data));
+    for(Limb& limb : data)
+        if(limb-- != 0) break;
+
+    removeInsignificantBits(data);
+}
+
+// number += value
+void addLimb(BinaryData& number, Limb value)
+{
+    for(Limb& limb : number)
     {
-        // is lhs less than rhs
-        return lhs.size() < rhs.size() ? true :
-               lhs.size() > rhs.size() ? false :
-               // lhs.size() == rhs.size()
-               std::lexicographical_compare(std::execution::par_unseq, lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+        limb += value;
+        if(limb >= value) return;
+        value = 1;
     }
 
-    template<class Iterator>
-    bool operator()(Iterator lhs_begin, Iterator lhs_end, const BinaryData& rhs)
+    number.push_back(1);
+}
+
+// number -= value, number must not be less than value
+void subLimb(BinaryData& number, Limb value)
+{
+    for(Limb& limb : number)
     {
-        isRandomAccessIterator<Iterator>();
-        if(size_t dist = std::distance(lhs_begin, lhs_end); dist < rhs.size()) return true;
-        else if(dist > rhs.size()) return false;
-        // dist == rhs.size()
-        return std::lexicographical_compare(std::execution::par_unseq, lhs_begin, lhs_end, rhs.cbegin(), rhs.cend());
+        const Limb before = limb;
+        limb -= value;
+        if(before >= value) break;
+        value = 1;
     }
 
-    template<class Iterator>
-    bool operator()(const BinaryData& rhs, Iterator lhs_begin, Iterator lhs_end)
+    removeInsignificantBits(number);
+}
+
+/**
+ *  Compares magnitudes
+ *  @return -1 if lhs < rhs, 0 if lhs == rhs, 1 if lhs > rhs
+ */
+int compare(const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) noexcept
+{
+    if(lhsSize != rhsSize) return lhsSize < rhsSize ? -1 : 1;
+    for(size_t i = lhsSize; i-- > 0;)
+        if(lhs[i] != rhs[i])
+            return lhs[i] < rhs[i] ? -1 : 1;
+
+    return 0;
+}
+
+inline int compare(LimbSpan lhs, LimbSpan rhs) noexcept
+{
+    return compare(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+inline int compare(const BinaryData& lhs, Limb rhs) noexcept
+{
+    if(lhs.size() > 1) return 1;
+    return lhs.front() < rhs ? -1 : (lhs.front() == rhs ? 0 : 1);
+}
+
+struct Less
+{
+    bool operator()(LimbSpan lhs, LimbSpan rhs) const noexcept
     {
-        isRandomAccessIterator<Iterator>();
-        if(size_t dist = std::distance(lhs_begin, lhs_end); dist < rhs.size()) return false;
-        else if(dist > rhs.size()) return true;
-        // dist == rhs.size()
-        return std::lexicographical_compare(std::execution::par_unseq, rhs.cbegin(), rhs.cend(), lhs_begin, lhs_end);
+        // is lhs less than rhs
+        return compare(lhs, rhs) < 0;
     }
 } less;
 
 struct Greater
 {
-    bool operator()(const BinaryData& lhs, const BinaryData& rhs)
+    bool operator()(LimbSpan lhs, LimbSpan rhs) const noexcept
     {
         return less(rhs, lhs);
     }
-
-    template<class Iterator>
-    bool operator()(Iterator lhs_begin, Iterator lhs_end, const BinaryData& rhs)
-    {
-        return less(rhs, lhs_begin, lhs_end);
-    }
 } greater;
 
 struct Equal
 {
-    bool operator()(const BinaryData& lhs, const BinaryData& rhs)
-    {
-        if( lhs.size() != rhs.size() ) return false;
-        // lhs.size() == rhs.size()
-        return std::equal(std::execution::par_unseq, lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-    }
-
-    template<class Iterator>
-    bool operator()(Iterator lhs_begin, Iterator lhs_end, const BinaryData& rhs)
+    bool operator()(LimbSpan lhs, LimbSpan rhs) const noexcept
     {
-        isRandomAccessIterator<Iterator>();
-        if( std::distance(lhs_begin, lhs_end) != rhs.size() ) return false;
-        // dist == rhs.size()
-        return std::equal(std::execution::par_unseq, lhs_begin, lhs_end, rhs.begin(), rhs.end());
+        return compare(lhs, rhs) == 0;
     }
 } equal;
 
 struct LessOrEqual
 {
-    bool operator()(const BinaryData& lhs, const BinaryData& rhs)
+    bool operator()(LimbSpan lhs, LimbSpan rhs) const noexcept
     {
-        return less(lhs, rhs) ? true : equal(lhs, rhs);
+        return compare(lhs, rhs) <= 0;
     }
-
-    template<class Iterator>
-    bool operator()(const BinaryData& rhs, Iterator lhs_begin, Iterator lhs_end)
-    {
-        isRandomAccessIterator<Iterator>();
-        return less(rhs, lhs_begin, lhs_end) ? true : equal(lhs_begin, lhs_end, rhs);
-    }
-
 } lessOrEqual;
 
 struct GreatOrEqual
 {
-    bool operator()(const BinaryData& lhs, const BinaryData& rhs)
+    bool operator()(LimbSpan lhs, LimbSpan rhs) const noexcept
     {
-        return greater(lhs, rhs) ? true : equal(lhs, rhs);
+        return compare(lhs, rhs) >= 0;
     }
 } greatOrEqual;
 
 struct Subtraction
 {
-    BinaryReturnType operator()(const BinaryData& minuend, const BinaryData& subtrahend)
+    BinaryData operator()(LimbSpan minuend, LimbSpan subtrahend) const
     {
         assert(lessOrEqual(subtrahend, minuend));
-        m_units = 0;
-        auto [result, it, isLoad] = proccess(subtrahend.crbegin(), subtrahend.crend(), minuend.crbegin());
-        addRest(result, it, minuend.crend(), isLoad);
+        BinaryData result(minuend.size());
+        [[maybe_unused]] Limb borrow = subLimbs(result.data(), minuend.data(), minuend.size(),
+                                                subtrahend.data(), subtrahend.size());
+        assert(borrow == 0);
         removeInsignificantBits(result);
-        return {result, m_units};
+        return result;
     }
+} subtraction;
 
-private:
-    size_t m_units;
-
-    template<class Iterator>
-    void addRest(BinaryData& number, Iterator startIt, Iterator endIt, bool isLoan)
+struct Addition
+{
+    BinaryData operator()(LimbSpan lhs, LimbSpan rhs) const
     {
-        if(isLoan)
-        {
-            for(; startIt != endIt; ++startIt)
-            {
-                if(*startIt == 1)
-                {
-                    number.push_front(0);
-                    ++startIt;
-                    isLoan = false;
-                    break;
-                }
+        const LimbSpan bigger = lhs.size() >= rhs.size() ? lhs : rhs;
+        const LimbSpan smaller = lhs.size() >= rhs.size() ? rhs : lhs;
 
-                number.push_front(1);
-                ++m_units;
-            }
-        }
+        BinaryData result(bigger.size());
+        if(Limb carry = addLimbs(result.data(), bigger.data(), bigger.size(), smaller.data(), smaller.size()); carry != 0)
+            result.push_back(carry);
+        return result;
+    }
+} addition;
 
-        for(;startIt != endIt; ++startIt)
-        {
-            if(*startIt == 1) ++m_units;
-            number.push_front(*startIt);
-        }
+// result = lhs + rhs mod modulus for operands below it, all size limbs; result may alias either operand
+inline void addMod(Limb* result, const Limb* lhs, const Limb* rhs, const Limb* modulus, size_t size) noexcept
+{
+    const Limb carry = addLimbs(result, lhs, size, rhs, size);
+    if(carry != 0 || compare(result, size, modulus, size) >= 0)
+        subLimbs(result, result, size, modulus, size);
+}
 
-        assert(startIt == endIt);
-        removeInsignificantBits(number);
+inline void subMod(Limb* result, const Limb* lhs, const Limb* rhs, const Limb* modulus, size_t size) noexcept
+{
+    if(subLimbs(result, lhs, size, rhs, size) != 0)
+        addLimbs(result, result, size, modulus, size);
+}
+
+/**
+ *  Binary gcd: both numbers lose their factors of two, then the smaller is subtracted from the larger
+ *  until they meet; single-limb pairs finish in native words
+ */
+BinaryData gcd(BinaryData lhs, BinaryData rhs)
+{
+    if(isZero(lhs)) return rhs;
+    if(isZero(rhs)) return lhs;
+
+    auto trailingZeros = [](const BinaryData& number)
+    {
+        size_t index{0};
+        while(number[index] == 0) ++index;
+        return index * LimbBits + countTrailingZeros(number[index]);
+    };
+    const size_t lhsZeros = trailingZeros(lhs), rhsZeros = trailingZeros(rhs);
+    rightShift(lhs, lhsZeros);
+    rightShift(rhs, rhsZeros);
+
+    while(lhs.size() > 1 || rhs.size() > 1)
+    {
+        const int order = compare(lhs, rhs);
+        if(order == 0) break;
+        if(order < 0) lhs.swap(rhs);
+        subLimbs(lhs.data(), lhs.data(), lhs.size(), rhs.data(), rhs.size());
+        removeInsignificantBits(lhs);
+        rightShift(lhs, trailingZeros(lhs));
     }
 
-    template<class Iterator>
-    ReturnType<Iterator> proccess(Iterator subtrahendStart, Iterator subtrahendEnd, Iterator minuendIt)
+    if(lhs.size() == 1 && rhs.size() == 1)
     {
-        BinaryData result;
-        bool isLoan = false;
-        for(; subtrahendStart != subtrahendEnd; ++subtrahendStart, ++minuendIt)
+        Limb a = lhs.front(), b = rhs.front();
+        while(a != b)
         {
-            if(*minuendIt > *subtrahendStart) // 1 0
-            {
-                if(isLoan)
-                {
-                    isLoan = false;
-                    result.push_front(0);
-                }
-                else
-                {
-                    ++m_units;
-                    result.push_front(1);
-                }
-            }
-            else if(*minuendIt < *subtrahendStart) // 0 1
-            {
-                if(!isLoan)
-                {
-                    ++m_units;
-                    result.push_front(1);
-                    isLoan = true;
-                }
-                else result.push_front(0);
-            }
-            else // 1 1 or 0 0
-            {
-                if(isLoan)
-                {
-                    ++m_units;
-                    result.push_front(1);
-                }
-                else result.push_front(0);
-            }
+            if(a < b) std::swap(a, b);
+            a -= b;
+            a >>= countTrailingZeros(a);
         }
-
-        return {result, minuendIt, isLoan};
+        lhs.front() = a;
     }
 
-} subtraction;
+    leftShift(lhs, std::min(lhsZeros, rhsZeros));
+    return lhs;
+}
 
-struct Addition
+/**
+ *  Montgomery arithmetic modulo an odd number below 2^64, values are kept in Montgomery form
+ */
+struct MontgomeryLimb
 {
-    BinaryReturnType operator()(const BinaryData& lhs, const BinaryData& rhs)
+    explicit MontgomeryLimb(Limb modulus) :
+        modulus{modulus},
+        inverse{modulus}
     {
-        m_units = 0;
-        if(lhs.size() <= rhs.size())
-        {
-            auto [result, it, isTransfer] = proccess(lhs.crbegin(), lhs.crend(), rhs.crbegin());
-            addRest(result, it, rhs.crend(), isTransfer);
-            return {result, m_units};
-        } else
+        assert((modulus & 1) == 1);
+        // Newton iteration doubles the correct low bits of modulus^-1 mod 2^64 each step
+        for(int i{0}; i < 5; ++i)
+            inverse *= 2 - modulus * inverse;
+
+        const Limb unit = (static_cast<Limb>(0) - modulus) % modulus;
+        one = unit;
+        square = static_cast<Limb>(static_cast<DoubleLimb>(unit) * unit % modulus);
+    }
+
+    // value * 2^-64 mod modulus, value must be below modulus * 2^64
+    inline Limb reduce(DoubleLimb value) const noexcept
+    {
+        const Limb low = static_cast<Limb>(value);
+        const Limb high = static_cast<Limb>(value >> LimbBits);
+        const Limb correction = static_cast<Limb>((static_cast<DoubleLimb>(low * inverse) * modulus) >> LimbBits);
+        return sub(high, correction);
+    }
+
+    inline Limb multiply(Limb lhs, Limb rhs) const noexcept { return reduce(static_cast<DoubleLimb>(lhs) * rhs); }
+    // branch free, the operands are random and a mispredicted branch costs more than the mask
+    inline Limb sub(Limb lhs, Limb rhs) const noexcept
+    {
+        return lhs - rhs + (modulus & (static_cast<Limb>(0) - static_cast<Limb>(lhs < rhs)));
+    }
+    inline Limb add(Limb lhs, Limb rhs) const noexcept { return sub(lhs, modulus - rhs); }
+    inline Limb toMontgomery(Limb value) const noexcept { return multiply(value % modulus, square); }
+    inline Limb fromMontgomery(Limb value) const noexcept { return reduce(value); }
+
+    Limb pow(Limb base, Limb exponent) const noexcept
+    {
+        Limb result = one;
+        for(; exponent != 0; exponent >>= 1)
         {
-            auto [result, it, isTransfer] = proccess(rhs.crbegin(), rhs.crend(), lhs.crbegin());
-            addRest(result, it, lhs.crend(), isTransfer);
-            return {result, m_units};
+            if(exponent & 1) result = multiply(result, base);
+            base = multiply(base, base);
         }
+        return result;
     }
 
-private:
+    Limb modulus;
+    Limb inverse;   // modulus^-1 mod 2^64
+    Limb one;       // 2^64 mod modulus
+    Limb square;    // 2^128 mod modulus
+};
+
+/**
+ *  Exact multiplication through number theoretic transforms modulo three primes below 2^63.
+ *  A limb is one coefficient, the convolution is restored by the chinese remainder theorem:
+ *  every coefficient is below length * 2^128 which is less than the product of the primes.
+ */
+struct NttMultiplication
+{
+    // result[0..lhsSize+rhsSize) = lhs * rhs, result must not alias the inputs
+    void operator()(Limb* result, const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) const
+    {
+        const size_t coefficients = lhsSize + rhsSize - 1;
+        size_t length{1};
+        while(length < coefficients) length <<= 1;
+        assert(length <= (size_t{1} << m_maxLog));
+
+        std::array<std::vector<Limb>, 3> residues;
+        for(size_t i{0}; i < residues.size(); ++i)
+            residues[i] = convolution(primes()[i], lhs, lhsSize, rhs, rhsSize, length);
 
-    size_t m_units;
+        combine(result, lhsSize + rhsSize, residues, coefficients);
+    }
+
+private:
 
-    template<class Iterator>
-    void addRest(BinaryData& number, Iterator startIt, Iterator endIt, bool isTransfer)
+    struct Prime
     {
-        if(isTransfer)
-        {
-            for(; startIt != endIt; ++startIt)
-            {
-                if(*startIt == 0)
-                {
-                    number.push_front(1);
-                    ++m_units;
-                    isTransfer = false;
-                    ++startIt;
-                    break;
-                }
+        MontgomeryLimb field;
+        Limb generator;
+    };
 
-                number.push_front(0);
-            }
-        }
+    static constexpr const size_t m_maxLog = 55;
 
-        for(;startIt != endIt; ++startIt)
+    static const std::array<Prime, 3>& primes()
+    {
+        static const std::array<Prime, 3> primes
         {
-            if(*startIt == 1) ++m_units;
-            number.push_front(*startIt);
-        }
+            Prime{ MontgomeryLimb(4179340454199820289ULL), 3 }, // 29 * 2^57 + 1
+            Prime{ MontgomeryLimb(2485986994308513793ULL), 5 }, // 69 * 2^55 + 1
+            Prime{ MontgomeryLimb(1945555039024054273ULL), 5 }, // 27 * 2^56 + 1
+        };
+        return primes;
+    }
 
-        if(isTransfer)
+    /**
+     *  roots[level + j] = w^j where w is a primitive (2 * level)-th root of unity, for every power of two level
+     */
+    static std::vector<Limb> roots(const Prime& prime, size_t length, bool inverse)
+    {
+        const MontgomeryLimb& field = prime.field;
+        std::vector<Limb> result(std::max<size_t>(length, 2));
+        for(size_t level{1}; level < length; level <<= 1)
         {
-            number.push_front(1);
-            ++m_units;
-            isTransfer = false;
+            Limb root = field.pow(field.toMontgomery(prime.generator), (field.modulus - 1) / (2 * level));
+            if(inverse) root = field.pow(root, field.modulus - 2);
+
+            result[level] = field.one;
+            for(size_t j{1}; j < level; ++j)
+                result[level + j] = field.multiply(result[level + j - 1], root);
         }
+        return result;
     }
 
-    template<class Iterator>
-    ReturnType<Iterator> proccess(Iterator lhsIt, Iterator endIt, Iterator rhsIt)
+    // decimation in frequency, natural order in, bit reversed order out
+    static void forward(const MontgomeryLimb& field, std::vector<Limb>& data, const std::vector<Limb>& roots)
     {
-        BinaryData result;
-        bool isTransfer = false;
-        for(; lhsIt != endIt; ++rhsIt, ++lhsIt)
-        {
-            if(*lhsIt == 1 && *rhsIt == 1)
-            {
-                if(isTransfer)
-                {
-                    ++m_units;
-                    result.push_front(1);
-                }
-                else
+        const size_t length = data.size();
+        for(size_t level = length / 2; level >= 1; level >>= 1)
+            for(size_t start{0}; start < length; start += 2 * level)
+                for(size_t j{0}; j < level; ++j)
                 {
-                    isTransfer = true;
-                    result.push_front(0);
+                    const Limb u = data[start + j];
+                    const Limb v = data[start + j + level];
+                    data[start + j] = field.add(u, v);
+                    data[start + j + level] = field.multiply(field.sub(u, v), roots[level + j]);
                 }
-            } else if(*lhsIt == 0 && *rhsIt == 0)
-            {
-                if (isTransfer)
-                {
-                    result.push_front(1);
-                    ++m_units;
-                }
-                else result.push_front(0);
+    }
 
-                isTransfer = false;
-            }
-            else if(*lhsIt != *rhsIt)
-            {
-                if(isTransfer)
-                    result.push_front(0);
-                else
+    // decimation in time, bit reversed order in, natural order out, not scaled
+    static void backward(const MontgomeryLimb& field, std::vector<Limb>& data, const std::vector<Limb>& roots)
+    {
+        const size_t length = data.size();
+        for(size_t level{1}; level < length; level <<= 1)
+            for(size_t start{0}; start < length; start += 2 * level)
+                for(size_t j{0}; j < level; ++j)
                 {
-                    result.push_front(1);
-                    ++m_units;
+                    const Limb u = data[start + j];
+                    const Limb v = field.multiply(data[start + j + level], roots[level + j]);
+                    data[start + j] = field.add(u, v);
+                    data[start + j + level] = field.sub(u, v);
                 }
-            }
+    }
+
+    /**
+     *  Cyclic convolution modulo the prime in normal (not Montgomery) form.
+     *  Inputs are used as raw Montgomery values x * 2^-64, the final scaling by 2^128 / length undoes that.
+     */
+    static std::vector<Limb> convolution(const Prime& prime, const Limb* lhs, size_t lhsSize,
+                                         const Limb* rhs, size_t rhsSize, size_t length)
+    {
+        const MontgomeryLimb& field = prime.field;
+        auto load = [&field, length](const Limb* number, size_t size)
+        {
+            std::vector<Limb> data(length, 0);
+            std::transform(number, number + size, data.begin(), [&field](const Limb& limb) { return limb % field.modulus; });
+            return data;
+        };
+
+        const std::vector<Limb> direct = roots(prime, length, false);
+        std::vector<Limb> lhsData = load(lhs, lhsSize);
+        forward(field, lhsData, direct);
+        if(lhs == rhs && lhsSize == rhsSize)
+        {
+            for(Limb& value : lhsData)
+                value = field.multiply(value, value);
+        }
+        else
+        {
+            std::vector<Limb> rhsData = load(rhs, rhsSize);
+            forward(field, rhsData, direct);
+            for(size_t i{0}; i < length; ++i)
+                lhsData[i] = field.multiply(lhsData[i], rhsData[i]);
         }
 
-        return {result, rhsIt, isTransfer};
-    }
+        backward(field, lhsData, roots(prime, length, true));
 
-} addition;
+        const Limb scale = field.multiply(field.pow(field.toMontgomery(length), field.modulus - 2), field.square);
+        for(Limb& value : lhsData)
+            value = field.multiply(value, scale);
+        return lhsData;
+    }
 
-struct Division
-{
-    enum class Mode
+    // Garner's algorithm per coefficient, then carries through a three limb window
+    static void combine(Limb* result, size_t resultSize, const std::array<std::vector<Limb>, 3>& residues, size_t coefficients)
     {
-        Div,
-        Mod
-    };
+        const MontgomeryLimb& first = primes()[0].field;
+        const MontgomeryLimb& second = primes()[1].field;
+        const MontgomeryLimb& third = primes()[2].field;
 
-    BinaryReturnType operator()(BinaryData dividend, BinaryData divisor, Mode mode)
-    {
-        BinaryData result;
-        BinaryData tmp = divisor;
-        size_t units = 0;
+        // constants in Montgomery form so multiply() returns a normal value
+        const Limb firstInverse = second.pow(second.toMontgomery(first.modulus), second.modulus - 2);
+        const Limb firstModThird = third.toMontgomery(first.modulus);
+        const Limb productInverse = third.pow(third.multiply(firstModThird, third.toMontgomery(second.modulus)), third.modulus - 2);
+        const DoubleLimb firstBySecond = static_cast<DoubleLimb>(first.modulus) * second.modulus;
 
-        while(greatOrEqual(dividend, divisor))
+        std::array<Limb, 4> window{0, 0, 0, 0};
+        for(size_t k{0}; k < resultSize; ++k)
         {
-            size_t diff = dividend.size() - divisor.size();
-            auto offsetIt = std::next(dividend.cbegin(), divisor.size());
-            size_t offset = lessOrEqual(divisor, dividend.cbegin(), offsetIt) ? diff : --diff;
-
-            if(mode == Mode::Div)
+            if(k < coefficients)
             {
-                std::tie(result, units) = addition(result, PrepareShiftedNumber(offset) );
-                std::tie(dividend, std::ignore) = subtraction(dividend, PrepareShiftedNumber(tmp, offset));
+                const Limb x1 = residues[0][k];
+                const Limb x2 = second.multiply(second.sub(residues[1][k], x1 % second.modulus), firstInverse);
+                const Limb x3 = third.multiply(third.sub(third.sub(residues[2][k], x1 % third.modulus),
+                                                         third.multiply(x2 % third.modulus, firstModThird)), productInverse);
+
+                // x1 + x2 * first + x3 * first * second
+                const DoubleLimb low = static_cast<DoubleLimb>(x2) * first.modulus + x1;
+                const DoubleLimb high = static_cast<DoubleLimb>(x3) * static_cast<Limb>(firstBySecond);
+                const DoubleLimb top = static_cast<DoubleLimb>(x3) * static_cast<Limb>(firstBySecond >> LimbBits);
+
+                std::array<Limb, 3> value{};
+                Limb carry = 0;
+                value[0] = addWithCarry(static_cast<Limb>(low), static_cast<Limb>(high), carry);
+                DoubleLimb middle = (low >> LimbBits) + (high >> LimbBits) + static_cast<Limb>(top) + carry;
+                value[1] = static_cast<Limb>(middle);
+                value[2] = static_cast<Limb>(middle >> LimbBits) + static_cast<Limb>(top >> LimbBits);
+                addLimbs(window.data(), window.data(), window.size(), value.data(), value.size());
             }
-            else // mode == Mode::Mod
-                std::tie(dividend, units) = subtraction(dividend, PrepareShiftedNumber(tmp, offset));
-        }
 
-        return mode == Mode::Div ? std::make_tuple(result, units)
-                                 : std::make_tuple(dividend, units);
+            result[k] = window[0];
+            std::copy(window.begin() + 1, window.end(), window.begin());
+            window.back() = 0;
+        }
     }
 
-private:
+} nttMultiplication;
+
+/**
+ *  Operand sizes (in limbs) at which the algorithms switch.
+ *  Defaults suit a typical x86-64 machine, BigInt::calibrate() measures them on the running one.
+ */
+struct Tuning
+{
+    size_t karatsubaThreshold{32};
+    size_t karatsubaSquareThreshold{48};
+    size_t toom3Threshold{160};
+    size_t fftThreshold{2048};
+    size_t burnikelZieglerThreshold{32};
+    size_t newtonThreshold{16384};
+} tuning;
 
-    BinaryData PrepareShiftedNumber(const BinaryData& data, size_t offset)
+/**
+ *  SignedData is a magnitude with a sign, used by algorithms whose intermediate values go negative
+ */
+struct SignedData
+{
+    BinaryData magnitude{0};
+    bool negative{false};
+};
+
+SignedData signedAdd(const SignedData& lhs, const SignedData& rhs)
+{
+    if(lhs.negative == rhs.negative)
+        return {addition(lhs.magnitude, rhs.magnitude), lhs.negative};
+
+    if(int order = compare(lhs.magnitude, rhs.magnitude); order >= 0)
+        return {subtraction(lhs.magnitude, rhs.magnitude), lhs.negative && order != 0};
+
+    return {subtraction(rhs.magnitude, lhs.magnitude), rhs.negative};
+}
+
+SignedData signedSub(const SignedData& lhs, const SignedData& rhs)
+{
+    return signedAdd(lhs, {rhs.magnitude, !rhs.negative && !isZero(rhs.magnitude)});
+}
+
+struct Multiplication
+{
+    BinaryData operator()(const BinaryData& multiplicand, const BinaryData& multiplier) const
     {
-        BinaryData result = data;
-        leftShift(result, offset);
+        const size_t size = multiplicand.size() + multiplier.size();
+        if(size <= m_stackLimbs)
+        {
+            // small products go through the stack so a result that fits inline never allocates
+            Limb buffer[m_stackLimbs];
+            if(&multiplicand == &multiplier)
+                sqrSchoolbook(buffer, multiplicand.data(), multiplicand.size());
+            else
+                mulSchoolbook(buffer, multiplicand.data(), multiplicand.size(), multiplier.data(), multiplier.size());
+            return normalized(buffer, size);
+        }
+
+        BinaryData result(size);
+        operator()(result.data(), multiplicand.data(), multiplicand.size(), multiplier.data(), multiplier.size());
+        removeInsignificantBits(result);
         return result;
     }
 
-    BinaryData PrepareShiftedNumber(size_t offset)
+    SignedData operator()(const SignedData& multiplicand, const SignedData& multiplier) const
     {
-        BinaryData result{1};
-        leftShift(result, offset);
-        return result;
+        BinaryData result = operator()(multiplicand.magnitude, multiplier.magnitude);
+        bool negative = multiplicand.negative != multiplier.negative && !isZero(result);
+        return {std::move(result), negative};
     }
 
-} division;
-
-struct Multiplication
-{
-    BinaryReturnType operator()(const BinaryData& multiplicand, const BinaryData& multiplier)
+    /**
+     *  result[0..lhsSize+rhsSize) = lhs * rhs, result must not alias the inputs.
+     *  Picks schoolbook, Karatsuba, Toom-3 or NTT by the size of the smaller operand,
+     *  operands that alias each other go through the squaring tiers.
+     */
+    void operator()(Limb* result, const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) const
     {
-        BinaryData result;
-        BinaryData tmp = multiplier;
-        auto changeSearchedBit = [](const Bit& bit) -> Bit { return bit == 1 ? 0 : 1; };
-        Bit searchedBit = changeSearchedBit(multiplicand.back());
-        size_t dist = 0, offset = dist;
-        bool isFirstIter{false};
-
-        for(auto it = multiplicand.crbegin(); it != multiplicand.crend();)
+        const size_t total = lhsSize + rhsSize;
+        lhsSize = significantSize(lhs, lhsSize);
+        rhsSize = significantSize(rhs, rhsSize);
+        if(lhsSize < rhsSize)
         {
-            it = find_first_of(it, multiplicand.crend(), searchedBit);
-            dist = std::distance(std::next(multiplicand.crbegin(), offset), it);
-            offset += dist;
-            leftShift(tmp, !isFirstIter ? dist : --dist);
-            isFirstIter = true;
-            searchedBit == 1 ?  ZeroToOne(result, tmp) : OneToZero(result, tmp, dist);
-            searchedBit = changeSearchedBit(searchedBit);
+            std::swap(lhs, rhs);
+            std::swap(lhsSize, rhsSize);
         }
 
-        return {result, m_units};
+        if(rhsSize == 0)
+            return std::fill(result, result + total, 0);
+
+        std::fill(result + lhsSize + rhsSize, result + total, 0);
+
+        if(lhs == rhs && lhsSize == rhsSize)
+            return square(result, lhs, lhsSize);
+
+        if(rhsSize < std::max(tuning.karatsubaThreshold, MinKaratsubaSize))
+            mulSchoolbook(result, lhs, lhsSize, rhs, rhsSize);
+        else if(rhsSize >= tuning.fftThreshold)
+            nttMultiplication(result, lhs, lhsSize, rhs, rhsSize);
+        else if(lhsSize >= 2 * rhsSize)
+            unbalanced(result, lhs, lhsSize, rhs, rhsSize);
+        else if(rhsSize < tuning.toom3Threshold)
+            karatsuba(result, lhs, lhsSize, rhs, rhsSize);
+        else
+            toom3(result, lhs, lhsSize, rhs, rhsSize);
     }
 
 private:
 
-    size_t m_units;
+    static constexpr const size_t m_stackLimbs = 2 * BIGINT_INLINE_LIMBS;
 
-    template<class Iterator>
-    Iterator find_first_of(Iterator start, Iterator end, const Bit& bit) const
-    {
-        for(; start != end; ++start)
-            if(*start == bit)
-                return start;
-
-        return end;
-    }
+    // Karatsuba recurses on halves plus a carry limb, which are shorter than the operand only from 4 limbs;
+    // lower thresholds set through tuning() are raised to this instead of recursing forever
+    static constexpr const size_t MinKaratsubaSize = 4;
 
-    BinaryData PrepareShiftedNumber(const BinaryData& data, size_t offset)
+    static BinaryData normalized(const Limb* limbs, size_t size)
     {
-        BinaryData result = data;
-        rightShift(result, offset);
-        return result;
+        while(size > 1 && limbs[size - 1] == 0) --size;
+        return BinaryData(limbs, limbs + size);
     }
 
-    // 1 0
-    void OneToZero(BinaryData& result, BinaryData& tmp, const size_t& offset)
+    static BinaryData slice(const Limb* number, size_t size, size_t from, size_t count)
     {
-        std::tie(result, m_units) = addition(result, tmp);
-        std::tie(result, m_units) = subtraction(result, PrepareShiftedNumber(tmp, offset));
-        leftShift(tmp);
+        if(from >= size) return BinaryData{0};
+        return normalized(number + from, std::min(count, size - from));
     }
 
-    // 0 1
-    void ZeroToOne(BinaryData& result, BinaryData& tmp)
+    // result[0..2*size) = number^2
+    void square(Limb* result, const Limb* number, size_t size) const
     {
-        std::tie(result, m_units) = addition(result, tmp);
-        leftShift(tmp);
+        if(size < std::max(tuning.karatsubaSquareThreshold, MinKaratsubaSize))
+            sqrSchoolbook(result, number, size);
+        else if(size >= tuning.fftThreshold)
+            nttMultiplication(result, number, size, number, size);
+        else if(size < tuning.toom3Threshold)
+            karatsubaSquare(result, number, size);
+        else
+            toom3(result, number, size, number, size);
     }
 
-} multiplication;
+    // (high * B + low)^2 = high^2 * B^2 + ((low + high)^2 - low^2 - high^2) * B + low^2
+    void karatsubaSquare(Limb* result, const Limb* number, size_t size) const
+    {
+        const size_t total = 2 * size;
+        const size_t half = size / 2;
+        const size_t highSize = size - half;
+        const Limb* high = number + half;
 
-} // namesapce Operation
+        square(result, number, half);
+        square(result + 2 * half, high, highSize);
 
-namespace Converter
-{
+        const size_t sumSize = highSize + 1;
+        std::vector<Limb> buffer(3 * sumSize);
+        Limb* sum = buffer.data();
+        Limb* middle = sum + sumSize;
 
-std::unordered_map<std::string, char> fromBinaryTo
-{
-    {"000", '0'},
-    {"001", '1'},
-    {"010", '2'},
-    {"011", '3'},
-    {"100", '4'},
-    {"101", '5'},
-    {"110", '6'},
-    {"111", '7'},
-
-    {"0000", '0'},
-    {"0001", '1'},
-    {"0010", '2'},
-    {"0011", '3'},
-    {"0100", '4'},
-    {"0101", '5'},
-    {"0110", '6'},
-    {"0111", '7'},
-    {"1000", '8'},
-    {"1001", '9'},
-    {"1010", 'A'},
-    {"1011", 'B'},
-    {"1100", 'C'},
-    {"1101", 'D'},
-    {"1110", 'E'},
-    {"1111", 'F'},
-};
+        sum[highSize] = addLimbs(sum, high, highSize, number, half);
+        const size_t significant = significantSize(sum, sumSize);
+        size_t middleSize = 2 * sumSize;
+        std::fill(middle, middle + middleSize, 0);
+        square(middle, sum, significant);
+        subLimbs(middle, middle, middleSize, result, 2 * half);
+        subLimbs(middle, middle, middleSize, result + 2 * half, 2 * highSize);
+        middleSize = significantSize(middle, middleSize);
 
-struct Validator
-{
-    template<class T>
-    bool operator()(T&& value)
-    {
-        return isValid(std::forward<T>(value));
+        assert(middleSize <= total - half);
+        addAt(result + half, total - half, middle, middleSize);
     }
 
-private:
-
-    static constexpr const char min = '0';
-    static constexpr const char max = '9';
-
-    bool isValid(const std::string& number)
+    // lhsSize >= 2 * rhsSize: multiply lhs by rhsSize-sized chunks so every product is balanced
+    void unbalanced(Limb* result, const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) const
     {
-        auto it = *number.cbegin() == '-' ? std::next(number.cbegin()) : number.cbegin();
-        auto validate = [min=min, max=max](const char& symbol) -> bool { return symbol >= min && symbol <= max; };
-        return std::all_of(it, number.cend(), validate);
+        const size_t total = lhsSize + rhsSize;
+        std::fill(result, result + total, 0);
+        std::vector<Limb> product(2 * rhsSize);
+        for(size_t offset{0}; offset < lhsSize; offset += rhsSize)
+        {
+            const size_t chunk = std::min(rhsSize, lhsSize - offset);
+            operator()(product.data(), lhs + offset, chunk, rhs, rhsSize);
+            addAt(result + offset, total - offset, product.data(), chunk + rhsSize);
+        }
     }
 
-    template< class T >
-    bool isValid(T&&) { return true; }
-
-} validator;
+    // lhsSize >= rhsSize > lhsSize / 2
+    void karatsuba(Limb* result, const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) const
+    {
+        const size_t total = lhsSize + rhsSize;
+        const size_t half = lhsSize / 2;
+        const size_t lhsHighSize = lhsSize - half;
+        const size_t rhsHighSize = rhsSize - half;
+        const Limb* lhsHigh = lhs + half;
+        const Limb* rhsHigh = rhs + half;
 
-/**
- *  FromBinary convert BinaryData to container for set base
- */
-class FromBinary
-{
-    constexpr static const unsigned short m_octalChanSize = 3;
-    constexpr static const unsigned short m_HexChanSize = 4;
+        // low * low and high * high go straight to their places in the result
+        operator()(result, lhs, half, rhs, half);
+        operator()(result + 2 * half, lhsHigh, lhsHighSize, rhsHigh, rhsHighSize);
 
-    template<class T>
-    static char toChar(const T& number) { return number+'0'; };
-    static unsigned charToInt(const char& symbol) { return symbol-'0'; };
+        const size_t lhsSumSize = lhsHighSize + 1;
+        const size_t rhsSumSize = std::max(half, rhsHighSize) + 1;
+        std::vector<Limb> buffer(2 * (lhsSumSize + rhsSumSize));
+        Limb* lhsSum = buffer.data();
+        Limb* rhsSum = lhsSum + lhsSumSize;
+        Limb* middle = rhsSum + rhsSumSize;
 
-    template<size_t N, class ReversIterator>
-    static char castHexOrOctalToBinary(ReversIterator& it, ReversIterator end)
-    {
-        static_assert (N == 3 || N == 4, "chan size must be 3 or 4");
-        std::string chan(N, '0');
+        lhsSum[lhsHighSize] = addLimbs(lhsSum, lhsHigh, lhsHighSize, lhs, half);
+        rhsSum[rhsSumSize - 1] = rhsHighSize >= half ? addLimbs(rhsSum, rhsHigh, rhsHighSize, rhs, half)
+                                                     : addLimbs(rhsSum, rhs, half, rhsHigh, rhsHighSize);
 
-        for(auto chanIt = chan.rbegin(); chanIt != chan.rend() && it != end; ++chanIt, ++it)
-            *chanIt = toChar(*it);
+        // (lhsLow + lhsHigh) * (rhsLow + rhsHigh) - low * low - high * high
+        size_t middleSize = lhsSumSize + rhsSumSize;
+        operator()(middle, lhsSum, lhsSumSize, rhsSum, rhsSumSize);
+        subLimbs(middle, middle, middleSize, result, 2 * half);
+        subLimbs(middle, middle, middleSize, result + 2 * half, lhsHighSize + rhsHighSize);
+        middleSize = significantSize(middle, middleSize);
 
-        return fromBinaryTo[chan];
+        assert(middleSize <= total - half);
+        addAt(result + half, total - half, middle, middleSize);
     }
 
-    template<size_t chanSize>
-    static std::string convertHexOrOctalToBinary(const BinaryData& binary)
+    // Toom-Cook 3 with Bodrato's evaluation points 0, 1, -1, -2, infinity
+    void toom3(Limb* result, const Limb* lhs, size_t lhsSize, const Limb* rhs, size_t rhsSize) const
     {
-        std::deque<char> tempResult(binary.size() / chanSize);
-        for(auto it = binary.crbegin(); it != binary.crend();)
+        const size_t part = (lhsSize + 2) / 3;
+        if(rhsSize <= 2 * part)
+            return karatsuba(result, lhs, lhsSize, rhs, rhsSize);
+
+        auto evaluate = [part](const Limb* number, size_t size) -> std::array<SignedData, 5>
         {
-            char symbol = castHexOrOctalToBinary<chanSize>(it, binary.crend());
-            tempResult.push_front(symbol);
-        }
+            SignedData low{slice(number, size, 0, part)};
+            SignedData middle{slice(number, size, part, part)};
+            SignedData high{slice(number, size, 2 * part, size)};
+
+            SignedData lowAndHigh = signedAdd(low, high);
+            SignedData atOne = signedAdd(lowAndHigh, middle);
+            SignedData atMinusOne = signedSub(lowAndHigh, middle);
+            SignedData atMinusTwo = signedAdd(atMinusOne, high);
+            leftShift(atMinusTwo.magnitude);
+            atMinusTwo = signedSub(atMinusTwo, low);
+
+            return {low, atOne, atMinusOne, atMinusTwo, high};
+        };
 
-        std::string result(std::max(static_cast<size_t>(1), tempResult.size()), '0');
-        std::move(tempResult.begin(), tempResult.end(), result.begin());
-        return result;
+        const bool isSquare = lhs == rhs && lhsSize == rhsSize;
+        const auto lhsPoints = evaluate(lhs, lhsSize);
+        const auto rhsPoints = isSquare ? std::array<SignedData, 5>{} : evaluate(rhs, rhsSize);
+        std::array<SignedData, 5> values;
+        for(size_t i{0}; i < values.size(); ++i)
+            values[i] = operator()(lhsPoints[i], isSquare ? lhsPoints[i] : rhsPoints[i]);
+
+        auto& [atZero, atOne, atMinusOne, atMinusTwo, atInfinity] = values;
+        auto halve = [](SignedData value) { rightShift(value.magnitude); return value; };
+        auto doubled = [](SignedData value) { leftShift(value.magnitude); return value; };
+
+        SignedData third = signedSub(atMinusTwo, atOne);
+        divRemLimb(third.magnitude.data(), third.magnitude.data(), third.magnitude.size(), 3);
+        removeInsignificantBits(third.magnitude);
+        SignedData first = halve(signedSub(atOne, atMinusOne));
+        SignedData second = signedSub(atMinusOne, atZero);
+        third = signedAdd(halve(signedSub(second, third)), doubled(atInfinity));
+        second = signedSub(signedAdd(second, first), atInfinity);
+        first = signedSub(first, third);
+
+        const size_t total = lhsSize + rhsSize;
+        std::fill(result, result + total, 0);
+        const std::array<const SignedData*, 5> coefficients{&atZero, &first, &second, &third, &atInfinity};
+        for(size_t i{0}; i < coefficients.size(); ++i)
+        {
+            const BinaryData& coefficient = coefficients[i]->magnitude;
+            assert(!coefficients[i]->negative);
+            if(isZero(coefficient)) continue;
+            assert(i * part + coefficient.size() <= total);
+            addAt(result + i * part, total - i * part, coefficient.data(), coefficient.size());
+        }
     }
 
-    static void aditionDecimal(std::deque<char>& result, const std::string& addendum)
-    {
-        if(result.empty()) result.push_back('0');
-        assert(result.size() <= addendum.size());
-        unsigned transfer = 0;
-        auto predicate = [&](const char& resultValue, const char& addendumValue = '0') -> char
-        {
-            assert(transfer <= 9);
-            unsigned newValue = charToInt(resultValue) + charToInt(addendumValue) + transfer;
-            assert(newValue < 100);
-            transfer = newValue / 10;
-            return toChar(newValue % 10);
-        };
+} multiplication;
 
-        std::transform(result.rbegin(), result.rend(), addendum.crbegin(), result.rbegin(), predicate);
-        std::transform(std::next(addendum.crbegin(), result.size()), addendum.crend(), std::front_inserter(result), predicate);
+struct Division
+{
+    struct Result
+    {
+        BinaryData quotient;
+        BinaryData remainder;
+    };
 
-        assert(transfer <= 9);
-        if(transfer != 0)
-            result.push_front(toChar(transfer));
+    /**
+     *  Picks Knuth's long division, Burnikel-Ziegler or Newton reciprocal division by the size of the divisor;
+     *  quotients much shorter than the divisor are computed from the top limbs only
+     */
+    Result operator()(const BinaryData& dividend, const BinaryData& divisor) const
+    {
+        return divide(dividend, divisor, &divisor);
     }
 
-    static void multiplicationBy2(std::string& result)
+    // a divisor the caller does not own as BinaryData is copied only for the recursive tiers
+    Result operator()(const BinaryData& dividend, LimbSpan divisor) const
     {
-        unsigned transfer = 0;
-        std::transform(result.rbegin(), result.rend(), result.rbegin(),
-                       [&](const char& digit) -> char
-        {
-            assert(transfer <= 9);
-            unsigned newValue = charToInt(digit)*2 + transfer;
-            transfer = newValue / 10;
-            return toChar(newValue % 10);
-        });
-
-        assert(transfer <= 9);
-        if(transfer != 0)
-            result.insert(result.cbegin(), toChar(transfer));
+        return divide(dividend, divisor, nullptr);
     }
 
-public:
-    static std::string ToBinary(const BinaryData& binary, Sign sign)
+    /**
+     *  Knuth's Algorithm D (TAOCP 4.3.1).
+     *  quotient[0..dividendSize-divisorSize+1), remainder[0..divisorSize);
+     *  divisorSize >= 2, dividendSize >= divisorSize and the top divisor limb is not zero.
+     */
+    void operator()(Limb* quotient, Limb* remainder, const Limb* dividend, size_t dividendSize,
+                    const Limb* divisor, size_t divisorSize) const
     {
-        std::string result;
+        assert(divisorSize >= 2 && dividendSize >= divisorSize && divisor[divisorSize - 1] != 0);
 
-        if(sign == Sign::Positive)
-        {
-            std::transform(binary.cbegin(), binary.cend(), std::back_inserter(result), [](const Bit& bit) -> char
-            { return toChar(bit); });
-            return result;
-        }
-        else
-        {
-            bool isIncremented{false};
-            std::transform(binary.crbegin(), binary.crend(), std::back_inserter(result), [&isIncremented](const Bit& bit) -> char
-            {
-                Bit newBit = bit == 1 ? 0 : 1;
-                if(isIncremented == false && newBit == 0)
-                {
-                    isIncremented = true;
-                    return '1';
-                }
-                if(isIncremented == false && newBit == 1)
-                    return '0';
+        // small operands keep their normalized copies on the stack
+        const size_t scratchSize = dividendSize + 1 + divisorSize;
+        Limb stack[m_stackLimbs];
+        std::vector<Limb> heap(scratchSize <= m_stackLimbs ? 0 : scratchSize);
+        Limb* numerator = scratchSize <= m_stackLimbs ? stack : heap.data();
+        Limb* normalized = numerator + dividendSize + 1;
 
-                if(isIncremented == true)
-                    return toChar(newBit);
-            });
+        // shift so the top divisor limb has its high bit set, then quotient estimates are off by at most 2
+        const size_t shift = countLeadingZeros(divisor[divisorSize - 1]);
+        shiftLeft(normalized, divisor, divisorSize, shift);
+        numerator[dividendSize] = shiftLeft(numerator, dividend, dividendSize, shift);
 
-            std::reverse(result.begin(), result.end());
-            return '1' + result;
-        }
+        knuth(quotient, numerator, dividendSize + 1, normalized, divisorSize);
+        shiftRight(remainder, numerator, divisorSize, shift);
     }
 
-    static std::string ToOctal(const BinaryData& binary)
-    {
-        return convertHexOrOctalToBinary<m_octalChanSize>(binary);
-    }
+private:
 
-    static std::string ToDecimal(const BinaryData& binary)
+    static constexpr const size_t m_stackLimbs = 4 * BIGINT_INLINE_LIMBS + 2;
+
+    // owned is the divisor as BinaryData when the caller has one, otherwise the recursive tiers copy it
+    Result divide(const BinaryData& dividend, LimbSpan divisor, const BinaryData* owned) const
     {
-        std::deque<char> tempResult;
-        std::string degree = "1";
+        assert(!isZero(divisor));
+        if(less(dividend, divisor))
+            return {BinaryData{0}, dividend};
 
-        for(auto it = binary.crbegin(); it != binary.crend(); ++it)
+        const size_t dividendSize = dividend.size();
+        const size_t divisorSize = divisor.size();
+        const size_t quotientSize = dividendSize - divisorSize + 1;
+        if(divisorSize == 1)
         {
-            if(*it == 1) aditionDecimal(tempResult, degree);
-            multiplicationBy2(degree);
+            BinaryData quotient(quotientSize);
+            Limb remainder = divRemLimb(quotient.data(), dividend.data(), dividendSize, divisor[0]);
+            removeInsignificantBits(quotient);
+            return {std::move(quotient), BinaryData{remainder}};
         }
 
-        std::string result(std::max(static_cast<size_t>(1), tempResult.size()), '0');
-        std::move(tempResult.begin(), tempResult.end(), result.begin());
-        return result;
-    }
-
-    template<class T>
-    static T toInt(const BinaryData& binary)
-    {
-        size_t degree = 1;
-        T result = 0;
-        for(auto it = binary.crbegin(); it != binary.crend(); ++it)
+        if(divisorSize < tuning.burnikelZieglerThreshold || quotientSize < tuning.burnikelZieglerThreshold)
         {
-            if(*it == 1) result += degree;
-            degree *= 2;
+            BinaryData quotient(quotientSize);
+            BinaryData remainder(divisorSize);
+            operator()(quotient.data(), remainder.data(), dividend.data(), dividendSize, divisor.data(), divisorSize);
+            removeInsignificantBits(quotient);
+            removeInsignificantBits(remainder);
+            return {std::move(quotient), std::move(remainder)};
         }
 
-        return result;
+        if(owned == nullptr)
+        {
+            const BinaryData copy(divisor.begin(), divisor.end());
+            return divide(dividend, copy, &copy);
+        }
+        if(quotientSize + 2 < divisorSize)
+            return truncated(dividend, *owned, quotientSize);
+        if(divisorSize >= tuning.newtonThreshold)
+            return newton(dividend, *owned);
+        return burnikelZiegler(dividend, *owned);
     }
 
-    static std::string ToHex(const BinaryData& binary)
+    /**
+     *  Algorithm D on normalized operands, in place: the top divisorSize limbs of numerator must be below divisor.
+     *  quotient[0..numeratorSize-divisorSize) gets the quotient, numerator[0..divisorSize) the remainder
+     *  and the limbs above it are cleared.
+     */
+    static void knuth(Limb* quotient, Limb* numerator, size_t numeratorSize, const Limb* divisor, size_t divisorSize) noexcept
     {
-        return convertHexOrOctalToBinary<m_HexChanSize>(binary);
-    }
+        const Limb top = divisor[divisorSize - 1];
+        const Limb next = divisor[divisorSize - 2];
+        for(size_t j = numeratorSize - divisorSize; j-- > 0;)
+        {
+            Limb* window = numerator + j;
+            const DoubleLimb current = (static_cast<DoubleLimb>(window[divisorSize]) << LimbBits) | window[divisorSize - 1];
+            DoubleLimb estimate = current / top;
+            DoubleLimb rest = current - estimate * top;
+            while((estimate >> LimbBits) != 0 ||
+                  estimate * next > ((rest << LimbBits) | window[divisorSize - 2]))
+            {
+                --estimate;
+                rest += top;
+                if((rest >> LimbBits) != 0) break;
+            }
 
-};
+            // window -= estimate * divisor, add the divisor back if the estimate was still one too big
+            Limb digit = static_cast<Limb>(estimate);
+            Limb carry = 0, borrow = 0;
+            for(size_t i{0}; i < divisorSize; ++i)
+            {
+                const DoubleLimb product = static_cast<DoubleLimb>(digit) * divisor[i] + carry;
+                carry = static_cast<Limb>(product >> LimbBits);
+                window[i] = subWithBorrow(window[i], static_cast<Limb>(product), borrow);
+            }
+            window[divisorSize] = subWithBorrow(window[divisorSize], carry, borrow);
+
+            if(borrow != 0)
+            {
+                --digit;
+                window[divisorSize] += addLimbs(window, window, divisorSize, divisor, divisorSize);
+            }
+
+            quotient[j] = digit;
+        }
+    }
 
-/**
- *   ToBinary convert any collection to binary format
- */
-class ToBinary
-{
     /**
-     * Division by 2
-     * @param number
-     * @return remainder
+     *  Burnikel-Ziegler recursive division (MPI-I-98-1-022).
+     *  The divisor is padded to base * 2^levels limbs so every level splits evenly,
+     *  then the dividend is consumed one divisor-sized block at a time.
      */
-    static Bit getRemainder(std::string& number, size_t& offset)
+    Result burnikelZiegler(const BinaryData& dividend, const BinaryData& divisor) const
     {
-        unsigned int remainder = 0;
-        unsigned int dividend;
-        unsigned int quot;
+        size_t base = divisor.size();
+        size_t levels{0};
+        for(; base >= blockThreshold(); ++levels)
+            base = (base + 1) / 2;
+        const size_t blockSize = base << levels;
+        const size_t shift = (blockSize - divisor.size()) * LimbBits + countLeadingZeros(divisor.back());
 
-        offset = number.find_first_not_of("0", offset);
-        auto it = std::next(number.begin(), offset);
-        std::transform(it, number.end(), it, [&](const char& value)
-        {
-            dividend = (remainder * 10) + (value-'0');
-            remainder = dividend & 1;
-            quot = dividend / 2;
-            return (quot+'0');
-        });
+        BinaryData normalized = divisor;
+        leftShift(normalized, shift);
+        BinaryData numerator = dividend;
+        leftShift(numerator, shift);
 
-        if(offset+1 == number.size() && *number.rbegin() == '0')
-            ++offset;
+        // a clear top bit keeps the top block below the divisor
+        const size_t blocks = std::max<size_t>(2, bitLength(numerator) / (blockSize * LimbBits) + 1);
+        numerator.resize(blocks * blockSize, 0);
 
-        return static_cast<Bit>(remainder);
+        BinaryData quotient((blocks - 1) * blockSize);
+        std::vector<Limb> scratch(blockSize);
+        for(size_t block = blocks - 1; block-- > 0;)
+            divideTwoByOne(quotient.data() + block * blockSize, numerator.data() + block * blockSize,
+                           normalized.data(), blockSize, scratch.data());
+
+        BinaryData remainder(numerator.data(), numerator.data() + blockSize);
+        removeInsignificantBits(remainder);
+        rightShift(remainder, shift);
+        removeInsignificantBits(quotient);
+        return {std::move(quotient), std::move(remainder)};
     }
 
-    static State fromDecimal(std::string number)
+    // blocks below this size go to Algorithm D, which needs at least two divisor limbs
+    static size_t blockThreshold() noexcept { return std::max<size_t>(tuning.burnikelZieglerThreshold, 4); }
+
+    // numerator[0..2*size) / divisor[0..size) with numerator[size..2*size) < divisor, remainder left in numerator[0..size)
+    void divideTwoByOne(Limb* quotient, Limb* numerator, const Limb* divisor, size_t size, Limb* scratch) const
     {
-        if(number == "-0" || number == "0") return State();
-        BinaryData binary;
-        size_t bits{0};
-        size_t offset{0};
-        Sign sign =  Sign::Positive;
+        if(size % 2 != 0 || size < blockThreshold())
+            return knuth(quotient, numerator, 2 * size, divisor, size);
+
+        const size_t half = size / 2;
+        divideThreeByTwo(quotient + half, numerator + half, divisor, half, scratch);
+        divideThreeByTwo(quotient, numerator, divisor, half, scratch);
+    }
 
-        if(number.front() == '-')
+    // numerator[0..3*half) / divisor[0..2*half) with numerator[half..3*half) < divisor, remainder left in numerator[0..2*half)
+    void divideThreeByTwo(Limb* quotient, Limb* numerator, const Limb* divisor, size_t half, Limb* scratch) const
+    {
+        const Limb* divisorHigh = divisor + half;
+        Limb carry = 0;
+        if(compare(numerator + 2 * half, half, divisorHigh, half) < 0)
         {
-            sign = Sign::Negative;
-            offset = 1;
+            divideTwoByOne(quotient, numerator + half, divisorHigh, half, scratch);
         }
-
-        while(offset != number.size())
+        else
         {
-            Bit bit = getRemainder(number, offset);
-            if(bit == 1) ++bits;
-            binary.push_front(bit);
+            // the top half equals divisorHigh: the estimate is B^half - 1 and the partial remainder is middle + divisorHigh
+            std::fill(quotient, quotient + half, ~Limb{0});
+            std::fill(numerator + 2 * half, numerator + 3 * half, 0);
+            carry = addLimbs(numerator + half, numerator + half, half, divisorHigh, half);
         }
 
-        return State(binary, bits, sign);
+        // the estimate is never too small, add the divisor back while the remainder is negative
+        multiplication(scratch, quotient, half, divisor, half);
+        Limb borrow = subLimbs(numerator, numerator, 2 * half, scratch, 2 * half);
+        while(borrow > carry)
+        {
+            for(size_t i{0}; i < half; ++i)
+                if(quotient[i]-- != 0) break;
+            carry += addLimbs(numerator, numerator, 2 * half, divisor, 2 * half);
+        }
     }
 
-    template<class T>
-    static State fromDecimal(T number)
-    {
-        BinaryData binary;
-        size_t bits{0};
-        Sign sign = Sign::Positive;
-        if(number < 0)
+    /**
+     *  Division by a precomputed reciprocal of the divisor, one divisor-sized block of the dividend per step.
+     *  Each quotient block is estimated from the top of the partial remainder and corrected by a few units.
+     */
+    Result newton(const BinaryData& dividend, const BinaryData& divisor) const
+    {
+        const size_t size = divisor.size();
+        const size_t shift = countLeadingZeros(divisor.back());
+        BinaryData normalized = divisor;
+        leftShift(normalized, shift);
+        BinaryData numerator = dividend;
+        leftShift(numerator, shift);
+        const BinaryData inverse = reciprocal(normalized);
+
+        // the top size limbs start the remainder, the rest of the dividend is brought down in chunks of at most size limbs
+        const size_t low = numerator.size() - size;
+        BinaryData quotient(low + 1, 0);
+        BinaryData remainder(numerator.data() + low, numerator.data() + numerator.size());
+        if(greatOrEqual(remainder, normalized))
         {
-            number = -number;
-            sign = Sign::Negative;
+            remainder = subtraction(remainder, normalized);
+            quotient[low] = 1;
         }
-        if(number == 0) return State();
-        while(number > 0)
+
+        for(size_t end = low; end > 0;)
         {
-            if(number&1) ++bits;
-            binary.push_front(number&1);
-            number /= 2;
+            const size_t start = end - (end % size == 0 ? size : end % size);
+
+            // window = remainder * B^(end-start) + numerator[start..end), below normalized * B^(end-start)
+            BinaryData window(numerator.data() + start, numerator.data() + end);
+            for(const Limb limb : remainder)
+                window.push_back(limb);
+            removeInsignificantBits(window);
+
+            BinaryData estimate = window;
+            rightShift(estimate, (size - 1) * LimbBits);
+            estimate = multiplication(estimate, inverse);
+            rightShift(estimate, (size + 1) * LimbBits);
+            remainder = adjust(estimate, window, normalized);
+            std::copy(estimate.begin(), estimate.end(), std::next(quotient.begin(), start));
+            end = start;
         }
 
-        return State(binary, bits, sign);
+        rightShift(remainder, shift);
+        removeInsignificantBits(quotient);
+        return {std::move(quotient), std::move(remainder)};
     }
 
-public:
+    /**
+     *  floor(B^(2n) / divisor) up to a few units for an n-limb divisor with its top bit set.
+     *  The reciprocal of the top half + 1 limbs is refined by one Newton step:
+     *  x = y * B^(n-h) + y * (B^(n+h) - divisor * y) / B^(2h)
+     */
+    BinaryData reciprocal(const BinaryData& divisor) const
+    {
+        const size_t size = divisor.size();
+        if(size < std::max<size_t>(tuning.newtonThreshold, 8))
+        {
+            BinaryData power(2 * size + 1, 0);
+            power.back() = 1;
+            if(size >= blockThreshold())
+                return burnikelZiegler(power, divisor).quotient;
+
+            BinaryData quotient(size + 2);
+            BinaryData remainder(size);
+            operator()(quotient.data(), remainder.data(), power.data(), power.size(), divisor.data(), size);
+            removeInsignificantBits(quotient);
+            return quotient;
+        }
 
-    template<class T>
-    static State convert(T&& value)
+        const size_t part = (size + 1) / 2 + 1;
+        const BinaryData approximation = reciprocal(BinaryData(divisor.data() + size - part, divisor.data() + size));
+
+        BinaryData power(size + part + 1, 0);
+        power.back() = 1;
+        // the low part limbs of the error move the result by less than a unit, so they are dropped before the product
+        SignedData error = signedSub({std::move(power), false}, {multiplication(divisor, approximation), false});
+        rightShift(error.magnitude, part * LimbBits);
+        SignedData correction = multiplication(SignedData{approximation, false}, error);
+        rightShift(correction.magnitude, part * LimbBits);
+        correction.negative = correction.negative && !isZero(correction.magnitude);
+
+        BinaryData scaled = approximation;
+        leftShift(scaled, (size - part) * LimbBits);
+        return signedAdd({std::move(scaled), false}, correction).magnitude;
+    }
+
+    // A short quotient only depends on the top limbs: divide those, then fix the estimate against the full operands
+    Result truncated(const BinaryData& dividend, const BinaryData& divisor, size_t quotientSize) const
     {
-        return validator(value) ? fromDecimal(value) : State();
+        const size_t drop = divisor.size() - (quotientSize + 2);
+        BinaryData quotient = operator()(BinaryData(dividend.data() + drop, dividend.data() + dividend.size()),
+                                         BinaryData(divisor.data() + drop, divisor.data() + divisor.size())).quotient;
+        BinaryData remainder = adjust(quotient, dividend, divisor);
+        return {std::move(quotient), std::move(remainder)};
+    }
+
+    // Moves a quotient estimate that is a few units off to the exact quotient, returns the remainder
+    static BinaryData adjust(BinaryData& quotient, const BinaryData& dividend, const BinaryData& divisor)
+    {
+        BinaryData product = multiplication(quotient, divisor);
+        while(greater(product, dividend))
+        {
+            product = subtraction(product, divisor);
+            Decrement(quotient);
+        }
+
+        BinaryData remainder = subtraction(dividend, product);
+        while(greatOrEqual(remainder, divisor))
+        {
+            remainder = subtraction(remainder, divisor);
+            Increment(quotient);
+        }
+        return remainder;
+    }
+
+    // result[0..size) = number << shift, returns the bits shifted out; shift < LimbBits
+    static Limb shiftLeft(Limb* result, const Limb* number, size_t size, size_t shift) noexcept
+    {
+        if(shift == 0)
+        {
+            std::copy(number, number + size, result);
+            return 0;
+        }
+
+        Limb carry = 0;
+        for(size_t i{0}; i < size; ++i)
+        {
+            const Limb limb = number[i];
+            result[i] = (limb << shift) | carry;
+            carry = limb >> (LimbBits - shift);
+        }
+        return carry;
+    }
+
+    // result[0..size) = number >> shift; shift < LimbBits
+    static void shiftRight(Limb* result, const Limb* number, size_t size, size_t shift) noexcept
+    {
+        if(shift == 0)
+        {
+            std::copy(number, number + size, result);
+            return;
+        }
+
+        for(size_t i{0}; i + 1 < size; ++i)
+            result[i] = (number[i] >> shift) | (number[i + 1] << (LimbBits - shift));
+        result[size - 1] = number[size - 1] >> shift;
+    }
+
+} division;
+
+/**
+ *  Montgomery arithmetic modulo an odd number of any length.
+ *  Residues are size-limb arrays holding value * R mod modulus with R = 2^(64 * size);
+ *  products go through the multiplication tiers and are folded back by Montgomery reduction.
+ */
+struct Montgomery
+{
+    explicit Montgomery(const BinaryData& modulus) :
+        modulus{modulus},
+        size{modulus.size()},
+        inverse{0}
+    {
+        assert((modulus.front() & 1) == 1);
+        // Newton iteration doubles the correct low bits of modulus^-1 mod 2^64 each step
+        Limb root = modulus.front();
+        for(int i{0}; i < 5; ++i)
+            root *= 2 - modulus.front() * root;
+        inverse = Limb{0} - root;
+
+        BinaryData power(size + 1);
+        power.back() = 1;
+        one = padded(division(power, modulus).remainder);
+        power = BinaryData(2 * size + 1);
+        power.back() = 1;
+        square = padded(division(power, modulus).remainder);
+    }
+
+    // limbs of scratch mul, sqr, to and from need
+    size_t scratchSize() const { return 2 * size; }
+
+    // result = lhs * rhs / R mod modulus, result may alias either operand
+    void mul(Limb* result, const Limb* lhs, const Limb* rhs, Limb* scratch) const
+    {
+        multiplication(scratch, lhs, size, rhs, size);
+        reduce(result, scratch);
+    }
+
+    void sqr(Limb* result, const Limb* number, Limb* scratch) const
+    {
+        multiplication(scratch, number, size, number, size);
+        reduce(result, scratch);
+    }
+
+    // result = product / R mod modulus for product[0..2 * size) below modulus * R, product is overwritten
+    void reduce(Limb* result, Limb* product) const
+    {
+        Limb extra{0};
+        for(size_t i{0}; i < size; ++i)
+        {
+            const Limb carry = addMulLimb(product + i, modulus.data(), size, product[i] * inverse);
+            const DoubleLimb sum = static_cast<DoubleLimb>(product[i + size]) + carry + extra;
+            product[i + size] = static_cast<Limb>(sum);
+            extra = static_cast<Limb>(sum >> LimbBits);
+        }
+
+        Limb* high = product + size;
+        if(extra != 0 || compare(high, size, modulus.data(), size) >= 0)
+            subLimbs(high, high, size, modulus.data(), size);
+        std::copy(high, high + size, result);
+    }
+
+    // value below the modulus into Montgomery form
+    void to(Limb* result, LimbSpan value, Limb* scratch) const
+    {
+        std::fill(std::copy(value.begin(), value.end(), result), result + size, 0);
+        mul(result, result, square.data(), scratch);
+    }
+
+    BinaryData from(const Limb* residue, Limb* scratch) const
+    {
+        std::fill(std::copy(residue, residue + size, scratch), scratch + 2 * size, 0);
+        BinaryData result(size);
+        reduce(result.data(), scratch);
+        removeInsignificantBits(result);
+        return result;
+    }
+
+    BinaryData padded(BinaryData number) const
+    {
+        number.resize(size, 0);
+        return number;
     }
 
+    BinaryData modulus;
+    size_t size;
+    Limb inverse;       // -modulus^-1 mod 2^64
+    BinaryData one;     // R mod modulus, size limbs
+    BinaryData square;  // R^2 mod modulus, size limbs
 };
 
+/**
+ *  Barrett reduction modulo any number, mu = floor(2^(128 * size) / modulus) is paid once.
+ *  Residues are plain values padded to size limbs; this is the path for even moduli.
+ */
+struct Barrett
+{
+    explicit Barrett(const BinaryData& modulus) :
+        modulus{modulus},
+        size{modulus.size()}
+    {
+        BinaryData power(2 * size + 1);
+        power.back() = 1;
+        mu = division(power, modulus).quotient;
+        // only modulus = b^(size-1) gives mu = b^(size+1); one less keeps the estimate within three of the quotient
+        if(mu.size() > size + 1) mu = BinaryData(size + 1, ~Limb{0});
+        mu.resize(size + 1, 0);
+
+        one = BinaryData(size);
+        one.front() = 1;
+    }
 
-} // namespace Converter
+    size_t scratchSize() const { return 7 * size + 4; }
 
+    void mul(Limb* result, const Limb* lhs, const Limb* rhs, Limb* scratch) const
+    {
+        multiplication(scratch, lhs, size, rhs, size);
+        reduce(result, scratch, scratch + 2 * size);
+    }
 
-} // namespace
+    void sqr(Limb* result, const Limb* number, Limb* scratch) const
+    {
+        multiplication(scratch, number, size, number, size);
+        reduce(result, scratch, scratch + 2 * size);
+    }
 
+    // result = number mod modulus for number[0..2 * size), scratch holds 5 * size + 4 limbs
+    void reduce(Limb* result, const Limb* number, Limb* scratch) const
+    {
+        // the estimate floor(floor(number / b^(size-1)) * mu / b^(size+1)) is at most three below the quotient
+        Limb* estimate = scratch;
+        Limb* product = estimate + 2 * size + 2;
+        Limb* remainder = product + 2 * size + 1;
+        multiplication(estimate, number + size - 1, size + 1, mu.data(), size + 1);
+        multiplication(product, estimate + size + 1, size + 1, modulus.data(), size);
 
+        // only the low size + 1 limbs matter, the difference is exact modulo b^(size+1)
+        subLimbs(remainder, number, size + 1, product, size + 1);
+        while(compare(remainder, significantSize(remainder, size + 1), modulus.data(), size) >= 0)
+            subLimbs(remainder, remainder, size + 1, modulus.data(), size);
+        std::copy(remainder, remainder + size, result);
+    }
 
-namespace BigInt
+    void to(Limb* result, LimbSpan value, Limb*) const
+    {
+        std::fill(std::copy(value.begin(), value.end(), result), result + size, 0);
+    }
+
+    BinaryData from(const Limb* residue, Limb*) const
+    {
+        BinaryData result(residue, residue + size);
+        removeInsignificantBits(result);
+        return result;
+    }
+
+    BinaryData modulus;
+    size_t size;
+    BinaryData mu;      // size + 1 limbs
+    BinaryData one;     // size limbs
+};
+
+/**
+ *  result = base^exponent in the residues of field, exponent must not be zero.
+ *  Sliding windows cut the multiplications to one per window; the odd powers of base are precomputed.
+ */
+template<class Field>
+void slidingWindowPow(const Field& field, Limb* result, const Limb* base, LimbSpan exponent, Limb* scratch)
 {
+    const size_t size = field.size;
+    const size_t bits = bitLength(exponent);
+    const size_t window = bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : 1;
 
-class BigInt final
+    std::vector<Limb> table((size_t{1} << (window - 1)) * size);
+    std::copy(base, base + size, table.begin());
+    if(window > 1)
+    {
+        std::vector<Limb> squared(size);
+        field.sqr(squared.data(), base, scratch);
+        for(size_t i{1}; i < (size_t{1} << (window - 1)); ++i)
+            field.mul(&table[i * size], &table[(i - 1) * size], squared.data(), scratch);
+    }
+
+    bool started{false};
+    for(size_t position = bits; position > 0;)
+    {
+        if(!testBit(exponent, position - 1))
+        {
+            field.sqr(result, result, scratch);
+            --position;
+            continue;
+        }
+
+        // the longest window below position that ends in a set bit
+        size_t low = position > window ? position - window : 0;
+        while(!testBit(exponent, low)) ++low;
+        size_t value{0};
+        for(size_t i = position; i-- > low;)
+            value = (value << 1) | testBit(exponent, i);
+
+        const Limb* power = &table[(value >> 1) * size];
+        if(!started)
+        {
+            std::copy(power, power + size, result);
+            started = true;
+        }
+        else
+        {
+            for(size_t i = low; i < position; ++i)
+                field.sqr(result, result, scratch);
+            field.mul(result, result, power, scratch);
+        }
+        position = low;
+    }
+}
+
+/**
+ *  base^exponent mod modulus for base below modulus: Montgomery for odd moduli, Barrett for even ones,
+ *  single-limb moduli stay in native words
+ */
+struct PowMod
 {
+    BinaryData operator()(LimbSpan base, LimbSpan exponent, const BinaryData& modulus) const
+    {
+        if(isZero(exponent)) return BinaryData{modulus.size() == 1 && modulus.front() == 1 ? 0u : 1u};
+        if(modulus.size() == 1) return BinaryData{single(base.front(), exponent, modulus.front())};
+        if(modulus.front() & 1) return run(Montgomery(modulus), base, exponent);
+        return run(Barrett(modulus), base, exponent);
+    }
 
-    template<class T, class Callback>
-    static BinaryReturnType process (const T& smaller, const T& bigger, Callback&& callback)
+private:
+
+    template<class Field>
+    static BinaryData run(const Field& field, LimbSpan base, LimbSpan exponent)
     {
-        size_t bits{0};
-        BinaryData result(bigger.size());
-        std::transform(smaller.crbegin(), smaller.crend(), bigger.crbegin(), result.rbegin(), [&](const Bit& lhs, const Bit& rhs)
+        std::vector<Limb> scratch(field.scratchSize());
+        std::vector<Limb> residue(field.size), result(field.size);
+        field.to(residue.data(), base, scratch.data());
+        slidingWindowPow(field, result.data(), residue.data(), exponent, scratch.data());
+        return field.from(result.data(), scratch.data());
+    }
+
+    static Limb single(Limb base, LimbSpan exponent, Limb modulus)
+    {
+        if(modulus & 1)
         {
-            Bit bit = callback(lhs, rhs);
-            if(bit == 1) ++bits;
-            return bit;
-        });
+            const MontgomeryLimb field(modulus);
+            const Limb residue = field.toMontgomery(base);
+            Limb result = field.one;
+            for(size_t i = bitLength(exponent); i-- > 0;)
+            {
+                result = field.multiply(result, result);
+                if(testBit(exponent, i)) result = field.multiply(result, residue);
+            }
+            return field.fromMontgomery(result);
+        }
 
-        size_t size = std::distance(smaller.crbegin(), smaller.crend());
-        std::transform(std::next(bigger.crbegin(), size), bigger.crend(), std::next(result.rbegin(), size), [&](const Bit& bit)
+        Limb result = 1 % modulus;
+        for(size_t i = bitLength(exponent); i-- > 0;)
         {
-            if(bit == 1) ++bits;
-            return bit;
-        });
+            result = static_cast<Limb>(static_cast<DoubleLimb>(result) * result % modulus);
+            if(testBit(exponent, i)) result = static_cast<Limb>(static_cast<DoubleLimb>(result) * base % modulus);
+        }
+        return result;
+    }
+} powmod;
 
-        Operation::removeInsignificantBits(result);
-        return {result, bits};
+/**
+ *  (F(index), F(index + 1)) mod modulus for a modulus above 1, fast doubling on (F(k - 1), F(k)) in Montgomery
+ *  or Barrett form with two squarings per bit: F(2k - 1) = F(k)^2 + F(k - 1)^2, F(2k + 1) = 4 F(k)^2 - F(k - 1)^2 + 2 (-1)^k
+ *  and F(2k) = F(2k + 1) - F(2k - 1)
+ */
+struct FibonacciMod
+{
+    std::pair<BinaryData, BinaryData> operator()(LimbSpan index, const BinaryData& modulus) const
+    {
+        if(modulus.front() & 1) return run(Montgomery(modulus), index);
+        return run(Barrett(modulus), index);
     }
 
-    template<class T, class Callback>
-    static BinaryReturnType conditionForProcess (const T& lhs, const T& rhs, Callback&& callback)
+private:
+
+    template<class Field>
+    static std::pair<BinaryData, BinaryData> run(const Field& field, LimbSpan index)
     {
-        return lhs.bit() <= rhs.bit() ?
-                        process(lhs.Number(), rhs.Number(), callback) :
-                        process(rhs.Number(), lhs.Number(), callback);
+        const size_t size = field.size;
+        const Limb* modulus = field.modulus.data();
+        std::vector<Limb> scratch(field.scratchSize());
+        std::vector<Limb> previous(size), current(field.one.cbegin(), field.one.cend()), square(size), previousSquare(size);
+        std::vector<Limb> two(size);
+        addMod(two.data(), current.data(), current.data(), modulus, size);
+
+        BinaryData last(index.begin(), index.end());
+        addLimb(last, 1);
+        bool odd{true};
+        for(size_t bit = bitLength(last) - 1; bit-- > 0;)
+        {
+            field.sqr(square.data(), current.data(), scratch.data());
+            field.sqr(previousSquare.data(), previous.data(), scratch.data());
+
+            // current = F(2k + 1), previous = F(2k - 1), square = F(2k)
+            addMod(current.data(), square.data(), square.data(), modulus, size);
+            addMod(current.data(), current.data(), current.data(), modulus, size);
+            subMod(current.data(), current.data(), previousSquare.data(), modulus, size);
+            if(odd) subMod(current.data(), current.data(), two.data(), modulus, size);
+            else addMod(current.data(), current.data(), two.data(), modulus, size);
+            addMod(previous.data(), square.data(), previousSquare.data(), modulus, size);
+            subMod(square.data(), current.data(), previous.data(), modulus, size);
+
+            odd = testBit(last, bit);
+            if(odd) previous.swap(square);
+            else current.swap(square);
+        }
+        return {field.from(previous.data(), scratch.data()), field.from(current.data(), scratch.data())};
     }
+} fibonacciMod;
 
-    template<class Callback>
-    static BigInt Transform(const BigInt& lhs, const BigInt& rhs, Callback&& callback)
+/**
+ *  Measures where Karatsuba starts beating schoolbook (for products and squares), Toom-3 starts beating Karatsuba
+ *  and the NTT starts beating Toom-3 on the running machine, installs and returns the result.
+ */
+Tuning calibrate()
+{
+    std::mt19937_64 generator(42);
+    auto randomNumber = [&generator](size_t size)
+    {
+        BinaryData number(size);
+        std::generate(number.begin(), number.end(), std::ref(generator));
+        number.back() |= Limb{1} << (LimbBits - 1);
+        return number;
+    };
+
+    // best of a few runs, each repeating the operation until it takes a measurable time
+    auto time = [](auto&& operation)
+    {
+        using Clock = std::chrono::steady_clock;
+        double best = std::numeric_limits<double>::max();
+        for(int run{0}; run < 3; ++run)
+        {
+            size_t loops{0};
+            const auto start = Clock::now();
+            auto elapsed = Clock::duration::zero();
+            do
+            {
+                operation();
+                ++loops;
+                elapsed = Clock::now() - start;
+            } while(elapsed < std::chrono::milliseconds(2));
+            best = std::min(best, std::chrono::duration<double>(elapsed).count() / loops);
+        }
+        return best;
+    };
+
+    auto measure = [&time](const BinaryData& lhs, const BinaryData& rhs)
+    {
+        std::vector<Limb> result(lhs.size() + rhs.size());
+        return time([&] { multiplication(result.data(), lhs.data(), lhs.size(), rhs.data(), rhs.size()); });
+    };
+
+    // first size from candidates where one level of the faster algorithm wins
+    auto crossover = [&](const std::vector<size_t>& candidates, size_t& threshold, size_t disabled, bool square = false)
     {
-        auto[result, bits] = conditionForProcess(lhs.isNegative() ? ~lhs : lhs,
-                                                 rhs.isNegative() ? ~rhs : rhs, callback);
-        return lhs.sign() == rhs.sign() ? BigInt(result, bits) : ~(BigInt(result, bits));
+        for(size_t size : candidates)
+        {
+            const BinaryData lhs = randomNumber(size), rhs = randomNumber(size);
+            const BinaryData& other = square ? lhs : rhs;
+            threshold = disabled;
+            const double slower = measure(lhs, other);
+            threshold = size;
+            const double faster = measure(lhs, other);
+            if(faster < slower) return size;
+        }
+        return candidates.back();
+    };
+
+    const size_t disabled = std::numeric_limits<size_t>::max();
+    tuning.toom3Threshold = disabled;
+    tuning.fftThreshold = disabled;
+    const size_t karatsuba = crossover({8, 12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 128}, tuning.karatsubaThreshold, disabled);
+    tuning.karatsubaThreshold = karatsuba;
+    tuning.karatsubaSquareThreshold = crossover({8, 12, 16, 24, 32, 40, 48, 64, 80, 96, 128, 160},
+                                                tuning.karatsubaSquareThreshold, disabled, true);
+    const size_t toom3 = crossover({64, 96, 128, 160, 192, 256, 320, 384, 512}, tuning.toom3Threshold, disabled);
+    tuning.toom3Threshold = std::max(toom3, 2 * karatsuba);
+    const size_t fft = crossover({256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096}, tuning.fftThreshold, disabled);
+    tuning.fftThreshold = std::max(fft, tuning.toom3Threshold);
+
+    // division splits a twice-as-long dividend; the Newton threshold is too large to time quickly and keeps its default
+    size_t burnikelZiegler{128};
+    for(size_t size : {16, 24, 32, 48, 64, 96, 128})
+    {
+        const BinaryData dividend = randomNumber(2 * size), divisor = randomNumber(size);
+        tuning.burnikelZieglerThreshold = disabled;
+        const double slower = time([&] { division(dividend, divisor); });
+        tuning.burnikelZieglerThreshold = size;
+        const double faster = time([&] { division(dividend, divisor); });
+        if(faster < slower)
+        {
+            burnikelZiegler = size;
+            break;
+        }
     }
+    tuning.burnikelZieglerThreshold = burnikelZiegler;
+    return tuning;
+}
 
-    State m_state;
+} // namesapce Operation
 
-    BigInt(const BinaryData& number, size_t bits = 0, Sign sign = Sign::Positive):
-        m_state(number, bits, sign)
-    {}
+namespace Primality
+{
 
-    BigInt(const State& state):
-        m_state{state}
-    {}
+// trial division runs over the odd primes below this bound
+constexpr const Limb TrialLimit = 1024;
 
-public:
-    BigInt():
-        m_state{State()}
-    {}
+// range sieves use the odd primes below this bound, nextPrime the ones below NextPrimeBound
+constexpr const Limb SieveLimit = Limb{1} << 20;
+constexpr const Limb NextPrimeBound = Limb{1} << 16;
 
-    BigInt(const std::string value) :
-        m_state{ Converter::ToBinary::convert( value ) }
-    {}
+// numbers per sieve segment, one segment is the unit of work of a thread
+constexpr const size_t SegmentWidth = size_t{1} << 18;
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
-    BigInt(T value)
-        : m_state{ Converter::ToBinary::convert( value ) }
-    {}
+/**
+ *  Odd primes below a limit, grouped so each group's product fits a limb:
+ *  one division by the product screens the whole group.
+ */
+struct SmallPrimes
+{
+    struct Group
+    {
+        Limb product;
+        size_t first;
+        size_t last;
+    };
 
-    inline const BinaryData& Number() const { return m_state.number; }
-    inline size_t count() const { return m_state.bitSet; }
-    inline size_t bit() const { return m_state.number.size(); }
-    inline Sign sign() const { return m_state.sign; }
-    inline bool is2Pow() const { return m_state.bitSet == 1; }
-    bool isPrime() const
+    explicit SmallPrimes(Limb limit)
+    {
+        std::vector<bool> composite(limit);
+        for(Limb prime = 3; prime < limit; prime += 2)
+        {
+            if(composite[prime]) continue;
+            primes.push_back(prime);
+            for(Limb multiple = prime * prime; multiple < limit; multiple += 2 * prime)
+                composite[multiple] = true;
+        }
+
+        Limb product{1};
+        size_t first{0};
+        for(size_t i{0}; i < primes.size(); ++i)
+        {
+            if(static_cast<DoubleLimb>(product) * primes[i] > std::numeric_limits<Limb>::max())
+            {
+                groups.push_back({product, first, i});
+                product = 1;
+                first = i;
+            }
+            product *= primes[i];
+        }
+        groups.push_back({product, first, primes.size()});
+    }
+
+    std::vector<Limb> primes;
+    std::vector<Group> groups;
+};
+
+const SmallPrimes& smallPrimes()
+{
+    static const SmallPrimes table(TrialLimit);
+    return table;
+}
+
+const SmallPrimes& sievePrimes()
+{
+    static const SmallPrimes table(SieveLimit);
+    return table;
+}
+
+// the smallest odd prime below TrialLimit that divides number, 0 if there is none
+Limb smallFactor(LimbSpan number)
+{
+    const SmallPrimes& table = smallPrimes();
+    for(const SmallPrimes::Group& group : table.groups)
+    {
+        const Limb residue = Operation::modLimb(number.data(), number.size(), group.product);
+        for(size_t i = group.first; i < group.last; ++i)
+            if(residue % table.primes[i] == 0) return table.primes[i];
+    }
+    return 0;
+}
+
+size_t trailingZeros(LimbSpan number) noexcept
+{
+    size_t index{0};
+    while(index + 1 < number.size() && number[index] == 0) ++index;
+    return index * LimbBits + Operation::countTrailingZeros(number[index]);
+}
+
+/**
+ *  Deterministic Miller-Rabin for an odd number above 3:
+ *  the primes up to 37 as bases are exact for every number below 3.3 * 10^24
+ */
+bool millerRabin(Limb number)
+{
+    const Operation::MontgomeryLimb field(number);
+    const size_t shift = Operation::countTrailingZeros(number - 1);
+    const Limb odd = (number - 1) >> shift;
+    const Limb minusOne = field.sub(0, field.one);
+
+    for(Limb base : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37})
+    {
+        if(base % number == 0) continue;
+        Limb power = field.pow(field.toMontgomery(base), odd);
+        if(power == field.one || power == minusOne) continue;
+
+        bool composite{true};
+        for(size_t i{1}; i < shift && composite; ++i)
+        {
+            power = field.multiply(power, power);
+            composite = power != minusOne;
+        }
+        if(composite) return false;
+    }
+    return true;
+}
+
+/**
+ *  Strong probable-prime test of the field's modulus to base, 1 < base < modulus - 1
+ */
+bool strongProbablePrime(const Operation::Montgomery& field, LimbSpan base)
+{
+    const size_t size = field.size;
+    std::vector<Limb> scratch(field.scratchSize()), residue(size), power(size), minusOne(size);
+    Operation::subLimbs(minusOne.data(), field.modulus.data(), size, field.one.data(), size);
+
+    BinaryData odd = field.modulus;
+    odd.front() -= 1;
+    const size_t shift = trailingZeros(odd);
+    Operation::rightShift(odd, shift);
+
+    field.to(residue.data(), base, scratch.data());
+    Operation::slidingWindowPow(field, power.data(), residue.data(), odd, scratch.data());
+    if(power == minusOne || std::equal(power.cbegin(), power.cend(), field.one.cbegin())) return true;
+
+    for(size_t i{1}; i < shift; ++i)
+    {
+        field.sqr(power.data(), power.data(), scratch.data());
+        if(power == minusOne) return true;
+        if(std::equal(power.cbegin(), power.cend(), field.one.cbegin())) return false;
+    }
+    return false;
+}
+
+// Jacobi symbol (value / number) for an odd number
+int jacobi(int64_t value, LimbSpan number) noexcept
+{
+    int result{1};
+    Limb top = value < 0 ? Limb{0} - static_cast<Limb>(value) : static_cast<Limb>(value);
+    Limb bottom = number.front();
+    if(value < 0 && (bottom & 3) == 3) result = -result;
+
+    // the first step brings the number down to a limb: (top / number) = +-(number mod top / top)
+    for(; top != 0 && (top & 1) == 0; top >>= 1)
+        if((bottom & 7) == 3 || (bottom & 7) == 5) result = -result;
+    if(top == 0) return number.size() == 1 && bottom == 1 ? result : 0;
+    if((top & 3) == 3 && (bottom & 3) == 3) result = -result;
+    bottom = top;
+    top = Operation::modLimb(number.data(), number.size(), top);
+
+    while(top != 0)
+    {
+        for(; (top & 1) == 0; top >>= 1)
+            if((bottom & 7) == 3 || (bottom & 7) == 5) result = -result;
+        std::swap(top, bottom);
+        if((top & 3) == 3 && (bottom & 3) == 3) result = -result;
+        top %= bottom;
+    }
+    return bottom == 1 ? result : 0;
+}
+
+/**
+ *  Strong Lucas probable-prime test of the field's modulus with P = 1 and Q = (1 - D) / 4, (D / modulus) must be -1.
+ *  U and V are doubled along the bits of the odd part of modulus + 1, all in Montgomery form.
+ */
+bool strongLucasProbablePrime(const Operation::Montgomery& field, int64_t discriminant)
+{
+    const size_t size = field.size;
+    const Limb* modulus = field.modulus.data();
+    std::vector<Limb> scratch(field.scratchSize());
+    std::vector<Limb> u(size), v(size), q(size), qPower(size), d(size), product(size);
+
+    auto residue = [&](Limb* result, int64_t value)
+    {
+        const Limb magnitude = value < 0 ? Limb{0} - static_cast<Limb>(value) : static_cast<Limb>(value);
+        field.to(result, BinaryData{magnitude}, scratch.data());
+        if(value < 0) Operation::subLimbs(result, modulus, size, result, size);
+    };
+    auto add = [&](Limb* result, const Limb* lhs, const Limb* rhs) { Operation::addMod(result, lhs, rhs, modulus, size); };
+    auto sub = [&](Limb* result, const Limb* lhs, const Limb* rhs) { Operation::subMod(result, lhs, rhs, modulus, size); };
+    // x / 2 is x >> 1 for even x and (x + modulus) >> 1 for odd x
+    auto half = [&](Limb* value)
+    {
+        Limb carry = (value[0] & 1) ? Operation::addLimbs(value, value, size, modulus, size) : 0;
+        for(size_t i = size; i-- > 0;)
+        {
+            const Limb low = value[i] & 1;
+            value[i] = (value[i] >> 1) | (carry << (LimbBits - 1));
+            carry = low;
+        }
+    };
+    // V_2k = V_k^2 - 2 Q^k
+    auto doubleV = [&]()
+    {
+        field.sqr(v.data(), v.data(), scratch.data());
+        sub(v.data(), v.data(), qPower.data());
+        sub(v.data(), v.data(), qPower.data());
+    };
+    auto isZero = [size](const std::vector<Limb>& value)
+    {
+        return std::all_of(value.cbegin(), value.cbegin() + size, [](Limb limb) { return limb == 0; });
+    };
+
+    residue(d.data(), discriminant);
+    residue(q.data(), (1 - discriminant) / 4);
+
+    BinaryData odd = field.modulus;
+    Operation::addLimb(odd, 1);
+    const size_t shift = trailingZeros(odd);
+    Operation::rightShift(odd, shift);
+
+    // U_1 = 1, V_1 = P = 1
+    std::copy(field.one.cbegin(), field.one.cend(), u.begin());
+    std::copy(field.one.cbegin(), field.one.cend(), v.begin());
+    qPower = q;
+    for(size_t i = Operation::bitLength(odd) - 1; i-- > 0;)
+    {
+        field.mul(u.data(), u.data(), v.data(), scratch.data());
+        doubleV();
+        field.sqr(qPower.data(), qPower.data(), scratch.data());
+        if(Operation::testBit(odd, i))
+        {
+            // U_2k+1 = (P U_2k + V_2k) / 2, V_2k+1 = (D U_2k + P V_2k) / 2
+            field.mul(product.data(), d.data(), u.data(), scratch.data());
+            add(u.data(), u.data(), v.data());
+            half(u.data());
+            add(v.data(), product.data(), v.data());
+            half(v.data());
+            field.mul(qPower.data(), qPower.data(), q.data(), scratch.data());
+        }
+    }
+
+    if(isZero(u) || isZero(v)) return true;
+    for(size_t r{1}; r < shift; ++r)
+    {
+        doubleV();
+        if(isZero(v)) return true;
+        field.sqr(qPower.data(), qPower.data(), scratch.data());
+    }
+    return false;
+}
+
+bool isSquare(const BinaryData& number)
+{
+    // quadratic residues modulo 64, 63 and 65 turn away most non-squares before the root is taken
+    const Limb low = number.front();
+    if(((0x0202021202030213ULL >> (low & 63)) & 1) == 0) return false;
+    const Limb residue = Operation::modLimb(number.data(), number.size(), 63 * 65);
+    auto isResidue = [](Limb value, Limb modulus)
+    {
+        for(Limb root{0}; root < modulus; ++root)
+            if(root * root % modulus == value) return true;
+        return false;
+    };
+    if(!isResidue(residue % 63, 63) || !isResidue(residue % 65, 65)) return false;
+
+    // Newton's iteration from above stops at the floor of the root
+    BinaryData root{1};
+    Operation::leftShift(root, (Operation::bitLength(number) + 1) / 2);
+    for(;;)
+    {
+        BinaryData next = Operation::addition(root, Operation::division(number, root).quotient);
+        Operation::rightShift(next, 1);
+        if(Operation::greatOrEqual(next, root)) break;
+        root = std::move(next);
+    }
+    return Operation::equal(Operation::multiplication(root, root), number);
+}
+
+/**
+ *  Exact below 2^64: trial division, then deterministic Miller-Rabin.
+ *  Above: trial division and Baillie-PSW (a strong base-2 test and a strong Lucas test with Selfridge's parameters),
+ *  followed by rounds Miller-Rabin tests to pseudo-random bases.
+ */
+bool isProbablePrime(const BinaryData& number, size_t rounds)
+{
+    if(number.size() == 1)
+    {
+        const Limb value = number.front();
+        if(value < 4) return value >= 2;
+        if((value & 1) == 0) return false;
+        if(const Limb factor = smallFactor(number); factor != 0) return factor == value;
+        if(value < TrialLimit * TrialLimit) return true;
+        return millerRabin(value);
+    }
+
+    if((number.front() & 1) == 0 || smallFactor(number) != 0) return false;
+
+    const Operation::Montgomery field(number);
+    if(!strongProbablePrime(field, BinaryData{2})) return false;
+
+    // Selfridge: the first D of 5, -7, 9, -11, ... with (D / number) = -1, which never comes for a square
+    int64_t discriminant{5};
+    for(size_t tries{0};; ++tries)
+    {
+        const int symbol = jacobi(discriminant, number);
+        if(symbol == -1) break;
+        if(symbol == 0) return false;
+        if(tries == 16 && isSquare(number)) return false;
+        discriminant = discriminant > 0 ? -(discriminant + 2) : -discriminant + 2;
+    }
+    if(!strongLucasProbablePrime(field, discriminant)) return false;
+
+    // bases in [2, number - 2], seeded by the number so a verdict is reproducible
+    std::mt19937_64 generator(number.front() ^ number.back());
+    BinaryData range = number;
+    Operation::subLimb(range, 3);
+    for(size_t round{0}; round < rounds; ++round)
+    {
+        BinaryData base(number.size());
+        std::generate(base.begin(), base.end(), std::ref(generator));
+        base = Operation::division(base, range).remainder;
+        Operation::addLimb(base, 2);
+        if(!strongProbablePrime(field, base)) return false;
+    }
+    return true;
+}
+
+/**
+ *  Sieve of Eratosthenes over the numbers start, start + 1, ... by 2 and the odd primes below bound.
+ *  The residues of start are computed once, so any segment at any offset costs no big-number work.
+ */
+class SegmentedSieve
+{
+public:
+    SegmentedSieve(const BinaryData& start, Limb bound) :
+        m_start{start},
+        m_bound{std::min(bound, SieveLimit)},
+        m_table{sievePrimes()},
+        m_count{static_cast<size_t>(std::lower_bound(m_table.primes.cbegin(), m_table.primes.cend(), m_bound) - m_table.primes.cbegin())},
+        m_residues(m_count)
+    {
+        for(const SmallPrimes::Group& group : m_table.groups)
+        {
+            if(group.first >= m_count) break;
+            const Limb residue = Operation::modLimb(start.data(), start.size(), group.product);
+            for(size_t i = group.first; i < std::min(group.last, m_count); ++i)
+                m_residues[i] = residue % m_table.primes[i];
+        }
+    }
+
+    /**
+     *  composite[i] for i in [0, length) tells whether start + offset + i is divisible by a sieving prime
+     *  other than itself; 0 and 1 count as composite
+     */
+    void mark(size_t offset, size_t length, std::vector<uint8_t>& composite) const
+    {
+        composite.assign(length, 0);
+        for(size_t i = ((m_start.front() + offset) & 1) ? 1 : 0; i < length; i += 2)
+            composite[i] = 1;
+
+        for(size_t k{0}; k < m_count; ++k)
+        {
+            const Limb prime = m_table.primes[k];
+            size_t i = (prime - (m_residues[k] + offset % prime) % prime) % prime;
+            if(value(offset + i) == prime) i += prime;
+            for(; i < length; i += prime)
+                composite[i] = 1;
+        }
+
+        // 0, 1 and 2 are the values the passes above get wrong
+        for(size_t i{0}; i < length && value(offset + i) <= 2; ++i)
+            composite[i] = value(offset + i) != 2;
+    }
+
+    BinaryData number(size_t offset) const
+    {
+        BinaryData result = m_start;
+        Operation::addLimb(result, offset);
+        return result;
+    }
+
+    // whether every survivor up to start + offset is prime: a composite below bound^2 has a factor below bound
+    bool exact(size_t offset) const
+    {
+        const BinaryData last = number(offset);
+        const DoubleLimb square = static_cast<DoubleLimb>(m_bound) * m_bound;
+        if(last.size() > 2) return false;
+        const DoubleLimb value = last.size() == 2 ? (static_cast<DoubleLimb>(last[1]) << LimbBits) | last[0] : last[0];
+        return value < square;
+    }
+
+private:
+    // start + offset when start is a single limb and the sum stays below 2^64, otherwise a value above every sieving prime
+    Limb value(size_t offset) const noexcept
+    {
+        if(m_start.size() > 1 || m_start.front() > std::numeric_limits<Limb>::max() - offset)
+            return std::numeric_limits<Limb>::max();
+        return m_start.front() + offset;
+    }
+
+    const BinaryData& m_start;
+    Limb m_bound;
+    const SmallPrimes& m_table;
+    size_t m_count;
+    std::vector<Limb> m_residues;
+};
+
+// the smallest prime above number
+BinaryData nextPrime(const BinaryData& number)
+{
+    BinaryData start = number;
+    Operation::addLimb(start, 1);
+
+    // a window holds a dozen prime gaps on average, the sieve clears all but a few candidates per gap
+    const size_t width = std::max<size_t>(1024, 8 * Operation::bitLength(number));
+    const SegmentedSieve sieve(start, NextPrimeBound);
+    std::vector<uint8_t> composite;
+    for(size_t offset{0};; offset += width)
+    {
+        sieve.mark(offset, width, composite);
+        const bool exact = sieve.exact(offset + width - 1);
+        for(size_t i{0}; i < width; ++i)
+        {
+            if(composite[i]) continue;
+            BinaryData candidate = sieve.number(offset + i);
+            if(exact || isProbablePrime(candidate, 0)) return candidate;
+        }
+    }
+}
+
+/**
+ *  Offsets i in [0, width) with start + i prime, in increasing order.
+ *  Segments go to threads one at a time; survivors of the sieve are tested unless the sieve is exact for the range.
+ */
+std::vector<size_t> primeOffsets(const BinaryData& start, size_t width, size_t threads)
+{
+    if(width == 0) return {};
+
+    BinaryData last = start;
+    Operation::addLimb(last, width - 1);
+    Limb bound = SieveLimit;
+    if(Operation::bitLength(last) <= 40)
+    {
+        // the primes up to the square root are enough to make the sieve exact
+        bound = static_cast<Limb>(std::sqrt(static_cast<double>(last.front())));
+        while(bound * bound <= last.front()) ++bound;
+    }
+    const SegmentedSieve sieve(start, bound);
+    const bool exact = sieve.exact(width - 1);
+
+    const size_t segments = (width + SegmentWidth - 1) / SegmentWidth;
+    std::vector<std::vector<size_t>> found(segments);
+    std::atomic<size_t> next{0};
+    auto worker = [&]()
+    {
+        std::vector<uint8_t> composite;
+        for(size_t segment; (segment = next.fetch_add(1)) < segments;)
+        {
+            const size_t offset = segment * SegmentWidth;
+            const size_t length = std::min(SegmentWidth, width - offset);
+            sieve.mark(offset, length, composite);
+            for(size_t i{0}; i < length; ++i)
+                if(!composite[i] && (exact || isProbablePrime(sieve.number(offset + i), 0)))
+                    found[segment].push_back(offset + i);
+        }
+    };
+
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for(size_t i{1}; i < std::min(threads, segments); ++i)
+        pool.emplace_back(worker);
+    worker();
+    for(std::thread& thread : pool)
+        thread.join();
+
+    std::vector<size_t> offsets;
+    for(const std::vector<size_t>& segment : found)
+        offsets.insert(offsets.end(), segment.cbegin(), segment.cend());
+    return offsets;
+}
+
+} // namespace Primality
+
+namespace Factorization
+{
+
+/**
+ *  Limits for factorize; composites still unsplit when one runs out are reported as they are
+ */
+struct Budget
+{
+    std::chrono::milliseconds time{0};  // wall time, 0 is unlimited
+    size_t curves{0};                   // ECM curves over the whole run, 0 is unlimited
+    size_t threads{1};                  // threads running ECM curves, 0 uses every hardware thread
+};
+
+// ECM work of each thread over a factorize run
+struct Statistics
+{
+    struct Worker
+    {
+        size_t curves{0};                   // curves run to completion
+        std::chrono::nanoseconds busy{0};   // time spent on curves, abandoned ones included
+
+        double curvesPerSecond() const
+        {
+            return busy.count() == 0 ? 0.0 : static_cast<double>(curves) * 1e9 / static_cast<double>(busy.count());
+        }
+    };
+
+    std::vector<Worker> workers;
+};
+
+// ECM stage 1 bound and the curves that make a factor of about digits decimal digits likely, after GMP-ECM
+struct EcmLevel
+{
+    size_t digits;
+    Limb bound;
+    size_t curves;
+};
+
+constexpr const std::array<EcmLevel, 7> EcmLevels
+{{
+    {15, 2000, 25}, {20, 11000, 90}, {25, 50000, 300}, {30, 250000, 700},
+    {35, 1000000, 1800}, {40, 3000000, 5100}, {45, 11000000, 10600}
+}};
+
+// stage 2 bounds are this multiple of the stage 1 bound
+constexpr const Limb Stage2Multiplier = 50;
+
+// trial division runs over the primes below this bound before any other method
+constexpr const Limb TrialBound = Primality::NextPrimeBound;
+
+constexpr const size_t RhoIterations = size_t{1} << 17;
+constexpr const Limb PollardBound = 100000;
+
+// primes for one pair of bounds: the ones up to the stage 1 bound and the gaps of the ones up to the stage 2 bound
+struct PrimeTable
+{
+    PrimeTable(Limb bound, Limb stage2Bound) :
+        bound{bound},
+        stage2Bound{stage2Bound}
+    {
+        // all gaps below 4 * 10^9 are under 512, half of one fits a byte
+        assert(stage2Bound < 4000000000ULL);
+        const BinaryData start{2};
+        const Limb last = stage2Bound + 1;
+        const Primality::SegmentedSieve sieve(start, static_cast<Limb>(std::sqrt(static_cast<double>(last))) + 1);
+        std::vector<uint8_t> composite;
+        Limb previous{0};
+        for(size_t offset{0}; offset < last - 2; offset += Primality::SegmentWidth)
+        {
+            const size_t length = std::min<size_t>(Primality::SegmentWidth, last - 2 - offset);
+            sieve.mark(offset, length, composite);
+            for(size_t i{0}; i < length; ++i)
+            {
+                if(composite[i]) continue;
+                const Limb prime = 2 + offset + i;
+                if(prime <= bound)
+                    primes.push_back(prime);
+                else if(previous <= bound)
+                    first = prime;
+                else
+                    halfGaps.push_back(static_cast<uint8_t>((prime - previous) / 2));
+                previous = prime;
+            }
+        }
+    }
+
+    Limb bound;
+    Limb stage2Bound;
+    std::vector<Limb> primes;       // up to bound
+    Limb first{0};                  // the first prime above bound
+    std::vector<uint8_t> halfGaps;  // between the following primes up to stage2Bound
+};
+
+const PrimeTable& primeTable(Limb bound)
+{
+    static std::mutex mutex;
+    static std::deque<PrimeTable> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    for(const PrimeTable& table : tables)
+        if(table.bound == bound) return table;
+    return tables.emplace_back(bound, bound * Stage2Multiplier);
+}
+
+/**
+ *  Montgomery residues of one odd modulus as fixed-size limb vectors,
+ *  the working set of the multi-limb methods; every operation reuses one scratch buffer
+ */
+class Ring
+{
+public:
+    using Value = std::vector<Limb>;
+
+    explicit Ring(const BinaryData& modulus) :
+        m_field{modulus},
+        m_scratch(m_field.scratchSize())
+    {}
+
+    inline size_t size() const { return m_field.size; }
+    inline const BinaryData& modulus() const { return m_field.modulus; }
+
+    // small constants only, the modulus has at least two limbs
+    Value value(Limb number)
+    {
+        Value result(size());
+        m_field.to(result.data(), BinaryData{number}, m_scratch.data());
+        return result;
+    }
+
+    Value one() const { return Value(m_field.one.cbegin(), m_field.one.cend()); }
+
+    void mul(Value& result, const Value& lhs, const Value& rhs) { m_field.mul(result.data(), lhs.data(), rhs.data(), m_scratch.data()); }
+    void sqr(Value& result, const Value& number) { m_field.sqr(result.data(), number.data(), m_scratch.data()); }
+    void add(Value& result, const Value& lhs, const Value& rhs) const { Operation::addMod(result.data(), lhs.data(), rhs.data(), modulus().data(), size()); }
+    void sub(Value& result, const Value& lhs, const Value& rhs) const { Operation::subMod(result.data(), lhs.data(), rhs.data(), modulus().data(), size()); }
+
+    void pow(Value& result, const Value& base, Limb exponent)
+    {
+        Operation::slidingWindowPow(m_field, result.data(), base.data(), BinaryData{exponent}, m_scratch.data());
+    }
+
+    // gcd of the residue with the modulus, R is a unit so the Montgomery factor does not matter
+    BinaryData gcd(const Value& number) const
+    {
+        BinaryData value(number.data(), number.data() + size());
+        Operation::removeInsignificantBits(value);
+        return Operation::gcd(std::move(value), modulus());
+    }
+
+    // the proper divisor in a gcd, empty for 1 and the modulus itself
+    BinaryData divisor(const Value& number) const
+    {
+        BinaryData common = gcd(number);
+        if(Operation::compare(common, 1) == 0 || Operation::equal(common, modulus())) return {};
+        return common;
+    }
+
+private:
+    Operation::Montgomery m_field;
+    Value m_scratch;
+};
+
+// Pollard rho with Brent's cycle detection on an odd composite below 2^64, always succeeds
+Limb rho(Limb number)
+{
+    const Operation::MontgomeryLimb field(number);
+    const size_t block{128};
+    for(Limb increment{1};; ++increment)
+    {
+        const Limb constant = field.toMontgomery(increment);
+        auto step = [&](Limb value) { return field.add(field.multiply(value, value), constant); };
+        auto distance = [](Limb lhs, Limb rhs) { return lhs > rhs ? lhs - rhs : rhs - lhs; };
+
+        Limb x{0}, y = field.toMontgomery(2), saved{0}, product = field.one, common{1};
+        for(size_t length{1}; common == 1; length *= 2)
+        {
+            x = y;
+            for(size_t i{0}; i < length; ++i) y = step(y);
+            for(size_t done{0}; done < length && common == 1; done += block)
+            {
+                saved = y;
+                for(size_t i{0}; i < std::min(block, length - done); ++i)
+                {
+                    y = step(y);
+                    product = field.multiply(product, distance(x, y));
+                }
+                common = std::gcd(product, number);
+            }
+        }
+
+        // the block overshot: walk it again one step at a time
+        if(common == number)
+        {
+            do
+            {
+                saved = step(saved);
+                common = std::gcd(distance(x, saved), number);
+            } while(common == 1);
+        }
+        if(common != number) return common;
+    }
+}
+
+// the parameter of the index-th curve, the splitmix64 finalizer spreads consecutive indices
+inline Limb curveSeed(Limb index) noexcept
+{
+    Limb seed = index * 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    return seed ^ (seed >> 31);
+}
+
+// the level the index-th curve on one composite runs at, the last level repeats forever
+inline const EcmLevel& ecmLevel(size_t index) noexcept
+{
+    for(const EcmLevel& level : EcmLevels)
+    {
+        if(index < level.curves) return level;
+        index -= level.curves;
+    }
+    return EcmLevels.back();
+}
+
+// a point on a Montgomery curve in projective x and z
+struct Point
+{
+    Ring::Value x;
+    Ring::Value z;
+};
+
+/**
+ *  One curve of Lenstra's ECM on a Montgomery curve with Suyama's parametrization, x and z only.
+ *  Stage 1 multiplies by every prime power up to the bound, stage 2 catches one more prime up to the
+ *  stage 2 bound with Montgomery's baby-step giant-step continuation.
+ *  Returns a proper divisor or nothing; stop() is polled between batches of primes and abandons the curve.
+ */
+template<class Stop>
+BinaryData ecm(Ring& ring, const PrimeTable& table, Limb seed, Stop&& stop)
+{
+    const size_t size = ring.size();
+    Ring::Value t1(size), t2(size), t3(size), t4(size);
+
+    // sigma >= 6 avoids the degenerate parameters
+    const Limb sigma = 6 + seed % (Limb{1} << 32);
+    Ring::Value u = ring.value(sigma), v = ring.value(4);
+    ring.mul(u, u, u);
+    ring.sub(u, u, ring.value(5));                  // u = sigma^2 - 5
+    ring.mul(v, v, ring.value(sigma));              // v = 4 sigma
+
+    Point point{Ring::Value(size), Ring::Value(size)};
+    ring.sqr(point.x, u);
+    ring.mul(point.x, point.x, u);                  // x = u^3
+    ring.sqr(point.z, v);
+    ring.mul(point.z, point.z, v);                  // z = v^3
+
+    // (A + 2) / 4 = (v - u)^3 (3u + v) / (16 u^3 v), kept as a fraction to avoid an inversion
+    Ring::Value numerator(size), denominator(size);
+    ring.sub(t1, v, u);
+    ring.sqr(numerator, t1);
+    ring.mul(numerator, numerator, t1);
+    ring.add(t2, u, u);
+    ring.add(t2, t2, u);
+    ring.add(t2, t2, v);
+    ring.mul(numerator, numerator, t2);
+    ring.mul(denominator, point.x, v);
+    ring.mul(denominator, denominator, ring.value(16));
+
+    auto doubled = [&](Point& result, const Point& p)
+    {
+        ring.add(t1, p.x, p.z);
+        ring.sqr(t1, t1);                           // (x + z)^2
+        ring.sub(t2, p.x, p.z);
+        ring.sqr(t2, t2);                           // (x - z)^2
+        ring.sub(t3, t1, t2);                       // 4xz
+        ring.mul(t4, denominator, t2);
+        ring.mul(result.x, t1, t4);
+        ring.mul(t1, numerator, t3);
+        ring.add(t4, t4, t1);
+        ring.mul(result.z, t3, t4);
+    };
+    // result = p + q from difference = p - q
+    auto added = [&](Point& result, const Point& p, const Point& q, const Point& difference)
+    {
+        ring.sub(t1, p.x, p.z);
+        ring.add(t2, q.x, q.z);
+        ring.mul(t1, t1, t2);
+        ring.add(t2, p.x, p.z);
+        ring.sub(t3, q.x, q.z);
+        ring.mul(t2, t2, t3);
+        ring.add(t3, t1, t2);
+        ring.sqr(t3, t3);
+        ring.sub(t4, t1, t2);
+        ring.sqr(t4, t4);
+        ring.mul(t3, t3, difference.z);
+        ring.mul(result.z, t4, difference.x);
+        result.x.swap(t3);
+        t3.resize(size);
+    };
+    // Montgomery's ladder keeps the difference of the pair equal to p
+    auto multiply = [&](const Point& p, Limb scalar)
+    {
+        Point low = p, high{Ring::Value(size), Ring::Value(size)};
+        doubled(high, p);
+        for(size_t bit = LimbBits - 1 - Operation::countLeadingZeros(scalar); bit-- > 0;)
+        {
+            if((scalar >> bit) & 1)
+            {
+                added(low, high, low, p);
+                doubled(high, high);
+            }
+            else
+            {
+                added(high, high, low, p);
+                doubled(low, low);
+            }
+        }
+        return low;
+    };
+
+    // stage 1, prime powers packed into limb-sized scalars
+    Limb scalar{1};
+    for(Limb prime : table.primes)
+    {
+        Limb power = prime;
+        while(power <= table.bound / prime) power *= prime;
+        if(scalar > std::numeric_limits<Limb>::max() / power)
+        {
+            if(stop()) return {};
+            point = multiply(point, scalar);
+            scalar = 1;
+        }
+        scalar *= power;
+    }
+    point = multiply(point, scalar);
+
+    BinaryData common = ring.gcd(point.z);
+    if(Operation::equal(common, ring.modulus())) return {};
+    if(Operation::compare(common, 1) != 0) return common;
+
+    // stage 2: R walks over r = r0, r0 + 2D, ... and S[d] = [2d]Q covers every prime r + 2d in between
+    const size_t half{128};
+    std::vector<Point> steps(half + 1, Point{Ring::Value(size), Ring::Value(size)});
+    std::vector<Ring::Value> products(half + 1, Ring::Value(size));
+    doubled(steps[1], point);
+    doubled(steps[2], steps[1]);
+    for(size_t d{3}; d <= half; ++d)
+        added(steps[d], steps[d - 1], steps[1], steps[d - 2]);
+    for(size_t d{1}; d <= half; ++d)
+        ring.mul(products[d], steps[d].x, steps[d].z);
+
+    Limb base = table.bound | 1;
+    if(base >= table.first) base -= 2;
+    Point current = multiply(point, base);
+    Point previous = multiply(point, base > 2 * half ? base - 2 * half : 2 * half - base);
+    Ring::Value accumulated = ring.one(), cross(size), product(size);
+    ring.mul(product, current.x, current.z);
+
+    Limb prime = table.first;
+    auto include = [&]()
+    {
+        while(prime > base + 2 * half)
+        {
+            Point next{Ring::Value(size), Ring::Value(size)};
+            added(next, current, steps[half], previous);
+            previous = std::move(current);
+            current = std::move(next);
+            base += 2 * half;
+            ring.mul(product, current.x, current.z);
+        }
+        // (x_R - x_S)(z_R + z_S) - x_R z_R + x_S z_S = x_R z_S - x_S z_R vanishes when [r]Q = [2d]Q
+        const Point& s = steps[(prime - base) / 2];
+        ring.sub(cross, current.x, s.x);
+        ring.add(t1, current.z, s.z);
+        ring.mul(cross, cross, t1);
+        ring.sub(cross, cross, product);
+        ring.add(cross, cross, products[(prime - base) / 2]);
+        ring.mul(accumulated, accumulated, cross);
+    };
+    include();
+    for(size_t i{0}; i < table.halfGaps.size(); ++i)
+    {
+        if(i % 4096 == 0 && stop()) return {};
+        prime += 2 * Limb{table.halfGaps[i]};
+        include();
+    }
+    return ring.divisor(accumulated);
+}
+
+/**
+ *  Splits composites into primes under a budget: trial division, then per composite
+ *  Pollard rho (Brent), Pollard p-1 and ECM with growing bounds.
+ *  ECM curves are independent, so they run on a pool of threads that all stop once one finds a divisor.
+ */
+class Engine
+{
+public:
+    explicit Engine(const Budget& budget) :
+        m_budget{budget},
+        m_deadline{std::chrono::steady_clock::now() + budget.time}
+    {
+        if(m_budget.threads == 0) m_budget.threads = std::max(1u, std::thread::hardware_concurrency());
+        statistics.workers.resize(m_budget.threads);
+    }
+
+    // prime factors and unsplit composites of number, unsorted with repeats
+    void run(BinaryData number)
+    {
+        if(Operation::isZero(number)) return;
+        trialDivision(number);
+
+        std::vector<BinaryData> pending;
+        if(Operation::compare(number, 1) != 0) pending.push_back(std::move(number));
+        while(!pending.empty())
+        {
+            BinaryData composite = std::move(pending.back());
+            pending.pop_back();
+            if(Primality::isProbablePrime(composite, 0))
+            {
+                primes.push_back(std::move(composite));
+                continue;
+            }
+
+            BinaryData divisor = split(composite);
+            if(divisor.empty())
+            {
+                composites.push_back(std::move(composite));
+                continue;
+            }
+            pending.push_back(Operation::division(composite, divisor).quotient);
+            pending.push_back(std::move(divisor));
+        }
+    }
+
+    std::vector<BinaryData> primes;
+    std::vector<BinaryData> composites;
+    Statistics statistics;
+
+private:
+    bool expired() const
+    {
+        return m_budget.time.count() != 0 && std::chrono::steady_clock::now() >= m_deadline;
+    }
+
+    bool exhausted() const
+    {
+        return (m_budget.curves != 0 && m_curves.load() >= m_budget.curves) || expired();
+    }
+
+    void trialDivision(BinaryData& number)
+    {
+        for(; !Operation::isZero(number) && (number.front() & 1) == 0; Operation::rightShift(number, 1))
+            primes.push_back(BinaryData{2});
+
+        const Primality::SmallPrimes& table = Primality::sievePrimes();
+        for(const Primality::SmallPrimes::Group& group : table.groups)
+        {
+            if(table.primes[group.first] >= TrialBound) break;
+            const Limb residue = Operation::modLimb(number.data(), number.size(), group.product);
+            for(size_t i = group.first; i < group.last; ++i)
+            {
+                const Limb prime = table.primes[i];
+                if(residue % prime != 0) continue;
+                BinaryData quotient(number.size());
+                while(Operation::divRemLimb(quotient.data(), number.data(), number.size(), prime) == 0)
+                {
+                    Operation::removeInsignificantBits(quotient);
+                    number = quotient;
+                    primes.push_back(BinaryData{prime});
+                }
+            }
+        }
+    }
+
+    // a proper divisor of an odd composite, empty when the budget runs out first
+    BinaryData split(const BinaryData& composite)
+    {
+        if(composite.size() == 1) return BinaryData{Factorization::rho(composite.front())};
+
+        Ring ring(composite);
+        if(BinaryData divisor = rho(ring); !divisor.empty()) return divisor;
+        if(BinaryData divisor = pollard(ring); !divisor.empty()) return divisor;
+
+        // curves are handed out by index, so the levels climb the same way for any number of threads
+        std::atomic<size_t> next{0};
+        std::atomic<bool> found{false};
+        std::mutex mutex;
+        BinaryData divisor;
+        auto worker = [&](Statistics::Worker& counters)
+        {
+            Ring local(composite);
+            auto stop = [&] { return found.load(std::memory_order_relaxed) || expired(); };
+            while(!stop())
+            {
+                if(m_budget.curves != 0 && m_curves.fetch_add(1) >= m_budget.curves) break;
+                const size_t index = next.fetch_add(1);
+                const PrimeTable& table = primeTable(ecmLevel(index).bound);
+
+                const auto start = std::chrono::steady_clock::now();
+                BinaryData result = ecm(local, table, curveSeed(m_seed + index), stop);
+                counters.busy += std::chrono::steady_clock::now() - start;
+                if(result.empty())
+                {
+                    if(!stop()) ++counters.curves;
+                    continue;
+                }
+
+                ++counters.curves;
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!found.load()) divisor = std::move(result);
+                found.store(true);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for(size_t i{1}; i < m_budget.threads; ++i)
+            pool.emplace_back(worker, std::ref(statistics.workers[i]));
+        worker(statistics.workers[0]);
+        for(std::thread& thread : pool)
+            thread.join();
+
+        // later composites get fresh curves
+        m_seed += next.load();
+        return divisor;
+    }
+
+    // Brent's rho with a bounded number of steps, products of 128 differences share one gcd
+    BinaryData rho(Ring& ring)
+    {
+        const size_t block{128};
+        const Ring::Value constant = ring.value(1);
+        Ring::Value x, y = ring.value(2), saved, product = ring.one(), difference(ring.size());
+        auto step = [&](Ring::Value& value) { ring.sqr(value, value); ring.add(value, value, constant); };
+
+        size_t steps{0};
+        for(size_t length{1}; steps < RhoIterations; length *= 2)
+        {
+            if(exhausted()) return {};
+            x = y;
+            for(size_t i{0}; i < length; ++i) step(y);
+            for(size_t done{0}; done < length; done += block)
+            {
+                saved = y;
+                for(size_t i{0}; i < std::min(block, length - done); ++i)
+                {
+                    step(y);
+                    ring.sub(difference, x, y);
+                    ring.mul(product, product, difference);
+                }
+                steps += std::min(block, length - done);
+
+                BinaryData common = ring.gcd(product);
+                if(Operation::compare(common, 1) == 0) continue;
+                if(!Operation::equal(common, ring.modulus())) return common;
+
+                // the block overshot: walk it again one step at a time
+                for(size_t i{0}; i < std::min(block, length - done); ++i)
+                {
+                    step(saved);
+                    ring.sub(difference, x, saved);
+                    if(BinaryData divisor = ring.divisor(difference); !divisor.empty()) return divisor;
+                }
+                return {};
+            }
+        }
+        return {};
+    }
+
+    // Pollard p-1: 2^(product of the prime powers below the bound), then one more prime up to the stage 2 bound
+    BinaryData pollard(Ring& ring)
+    {
+        const PrimeTable& table = primeTable(PollardBound);
+        Ring::Value power = ring.value(2), difference(ring.size());
+        const Ring::Value one = ring.one();
+        for(Limb prime : table.primes)
+        {
+            Limb exponent = prime;
+            while(exponent <= table.bound / prime) exponent *= prime;
+            ring.pow(power, power, exponent);
+        }
+        ring.sub(difference, power, one);
+        if(BinaryData divisor = ring.divisor(difference); !divisor.empty()) return divisor;
+        if(exhausted()) return {};
+
+        // power^q for the following primes q, stepping by the precomputed even powers
+        std::vector<Ring::Value> steps(256, Ring::Value(ring.size()));
+        ring.sqr(steps[1], power);
+        for(size_t i{2}; i < steps.size(); ++i)
+            ring.mul(steps[i], steps[i - 1], steps[1]);
+
+        Ring::Value current(ring.size()), product = ring.one();
+        ring.pow(current, power, table.first);
+        for(uint8_t gap : table.halfGaps)
+        {
+            ring.sub(difference, current, one);
+            ring.mul(product, product, difference);
+            ring.mul(current, current, steps[gap]);
+        }
+        ring.sub(difference, current, one);
+        ring.mul(product, product, difference);
+        return ring.divisor(product);
+    }
+
+    Budget m_budget;
+    std::chrono::steady_clock::time_point m_deadline;
+    std::atomic<size_t> m_curves{0};
+    Limb m_seed{0};
+};
+
+} // namespace Factorization
+
+namespace Parallel
+{
+
+// products of fewer limbs than this stay on the calling thread
+constexpr const size_t ParallelProductLimbs = 4096;
+
+// leaves per thread a parallel product tree is cut into, so threads that finish early have blocks to steal
+constexpr const size_t LeavesPerThread = 8;
+
+/**
+ *  Work-stealing scheduler for one batch of tasks. Every thread pops its own deque from the back,
+ *  an idle thread steals from the front of the others, and a running task may push follow-up tasks
+ *  to its thread's deque; run() returns once every task, pushed before or during it, has finished.
+ */
+template<class Task>
+class WorkStealing
+{
+public:
+    explicit WorkStealing(size_t threads) :
+        m_queues(threads)
+    {}
+
+    void push(size_t thread, Task task)
+    {
+        m_pending.fetch_add(1);
+        Queue& queue = m_queues[thread];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // execute(thread, task) for every task, the calling thread is thread 0
+    template<class Execute>
+    void run(Execute&& execute)
+    {
+        auto worker = [&](size_t thread)
+        {
+            Task task;
+            while(m_pending.load() != 0)
+            {
+                if(!take(thread, task))
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    continue;
+                }
+                execute(thread, task);
+                m_pending.fetch_sub(1);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for(size_t i{1}; i < m_queues.size(); ++i)
+            pool.emplace_back(worker, i);
+        worker(0);
+        for(std::thread& thread : pool)
+            thread.join();
+    }
+
+private:
+    bool take(size_t thread, Task& task)
+    {
+        for(size_t i{0}; i < m_queues.size(); ++i)
+        {
+            Queue& queue = m_queues[(thread + i) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(queue.tasks.empty()) continue;
+            if(i == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<Queue> m_queues;
+    std::atomic<size_t> m_pending{0};
+};
+
+/**
+ *  Product of count factors as a balanced tree cut into blocks of about grain factors.
+ *  leaf(first, last) multiplies one block on whichever thread takes it; the thread that finishes
+ *  the second child of a node multiplies the node, so no thread ever waits on another.
+ */
+template<class Leaf>
+BinaryData product(size_t count, size_t threads, size_t grain, Leaf&& leaf)
+{
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if(threads == 1 || count <= grain) return leaf(0, count);
+
+    struct Node
+    {
+        size_t first;
+        size_t last;
+        size_t parent;
+        size_t left{0};
+        size_t right{0};
+        std::atomic<int> pending{2};
+        BinaryData value;
+    };
+
+    const size_t none = std::numeric_limits<size_t>::max();
+    std::deque<Node> nodes;
+    std::vector<size_t> leaves;
+    std::function<size_t(size_t, size_t, size_t)> build = [&](size_t first, size_t last, size_t parent)
+    {
+        const size_t index = nodes.size();
+        nodes.emplace_back();
+        nodes[index].first = first;
+        nodes[index].last = last;
+        nodes[index].parent = parent;
+        if(last - first <= grain)
+        {
+            leaves.push_back(index);
+            return index;
+        }
+        const size_t middle = first + (last - first) / 2;
+        nodes[index].left = build(first, middle, index);
+        nodes[index].right = build(middle, last, index);
+        return index;
+    };
+    build(0, count, none);
+
+    // neighbouring leaves start on the same thread
+    WorkStealing<size_t> scheduler(threads);
+    for(size_t i{0}; i < leaves.size(); ++i)
+        scheduler.push(i * threads / leaves.size(), leaves[i]);
+
+    scheduler.run([&](size_t thread, size_t index)
+    {
+        Node& node = nodes[index];
+        if(node.left == node.right)
+        {
+            node.value = leaf(node.first, node.last);
+        }
+        else
+        {
+            node.value = Operation::multiplication(nodes[node.left].value, nodes[node.right].value);
+            BinaryData().swap(nodes[node.left].value);
+            BinaryData().swap(nodes[node.right].value);
+        }
+        if(node.parent != none && nodes[node.parent].pending.fetch_sub(1) == 1)
+            scheduler.push(thread, node.parent);
+    });
+    return std::move(nodes.front().value);
+}
+
+} // namespace Parallel
+
+namespace Combinatorics
+{
+
+// below this many limbs a product is accumulated one limb at a time
+constexpr const size_t ProductLeaf = 16;
+
+// binomial(n, k) with k below n / DirectBinomialRatio multiplies n - k + 1 ... n and divides by k! instead of sieving up to n
+constexpr const Limb DirectBinomialRatio = 64;
+
+// the primes up to last
+std::vector<Limb> primesUpTo(Limb last, size_t threads)
+{
+    if(last < 2) return {};
+    const std::vector<size_t> offsets = Primality::primeOffsets(BinaryData{2}, last - 1, threads);
+    std::vector<Limb> primes(offsets.size());
+    std::transform(offsets.cbegin(), offsets.cend(), primes.begin(), [](size_t offset) { return Limb{2} + offset; });
+    return primes;
+}
+
+// exponent of prime in n!
+inline Limb legendre(Limb n, Limb prime) noexcept
+{
+    Limb exponent{0};
+    for(; n >= prime; n /= prime) exponent += n / prime;
+    return exponent;
+}
+
+BinaryData productTree(const Limb* factors, size_t count)
+{
+    if(count <= ProductLeaf)
+    {
+        BinaryData result{count == 0 ? Limb{1} : factors[0]};
+        for(size_t i{1}; i < count; ++i)
+            if(const Limb carry = Operation::mulLimb(result.data(), result.data(), result.size(), factors[i]); carry != 0)
+                result.push_back(carry);
+        return result;
+    }
+    const size_t half = count / 2;
+    return Operation::multiplication(productTree(factors, half), productTree(factors + half, count - half));
+}
+
+BinaryData productTree(const LimbSpan* factors, size_t count)
+{
+    if(count == 0) return BinaryData{1};
+    if(count == 1) return BinaryData(factors[0].begin(), factors[0].end());
+    const size_t half = count / 2;
+    return Operation::multiplication(productTree(factors, half), productTree(factors + half, count - half));
+}
+
+// blocks of a parallel tree over count factors of about limbs limbs in total
+inline size_t grain(size_t count, size_t limbs, size_t threads) noexcept
+{
+    if(limbs < Parallel::ParallelProductLimbs) return count;
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, count / (threads * Parallel::LeavesPerThread));
+}
+
+/**
+ *  Product of nonzero limb factors. Neighbours are packed while they fit a limb, then halves are
+ *  multiplied recursively so both operands of every multiplication have about the same length
+ *  and the large ones reach the fast multiplication tiers. Long products spread their subtrees over threads.
+ */
+BinaryData product(const std::vector<Limb>& factors, size_t threads)
+{
+    std::vector<Limb> packed;
+    Limb current{1};
+    for(Limb factor : factors)
+    {
+        if(current > std::numeric_limits<Limb>::max() / factor)
+        {
+            packed.push_back(current);
+            current = 1;
+        }
+        current *= factor;
+    }
+    packed.push_back(current);
+    return Parallel::product(packed.size(), threads, grain(packed.size(), packed.size(), threads),
+                             [&](size_t first, size_t last) { return productTree(packed.data() + first, last - first); });
+}
+
+// product of nonzero numbers, balanced by count
+BinaryData product(const std::vector<LimbSpan>& factors, size_t threads)
+{
+    size_t limbs{0};
+    for(LimbSpan factor : factors) limbs += factor.size();
+    return Parallel::product(factors.size(), threads, grain(factors.size(), limbs, threads),
+                             [&](size_t first, size_t last) { return productTree(factors.data() + first, last - first); });
+}
+
+// product of primes[i]^exponents[i], bit by bit of the exponents from the top so large powers come from squarings
+BinaryData powerProduct(const std::vector<Limb>& primes, const std::vector<Limb>& exponents, size_t threads)
+{
+    const Limb highest = exponents.empty() ? 0 : *std::max_element(exponents.cbegin(), exponents.cend());
+    BinaryData result{1};
+    std::vector<Limb> factors;
+    for(size_t bit = highest == 0 ? 0 : LimbBits - Operation::countLeadingZeros(highest); bit-- > 0;)
+    {
+        result = Operation::multiplication(result, result);
+        factors.clear();
+        for(size_t i{0}; i < primes.size(); ++i)
+            if((exponents[i] >> bit) & 1) factors.push_back(primes[i]);
+        result = Operation::multiplication(result, product(factors, threads));
+    }
+    return result;
+}
+
+// odd part of n! / ((n / 2)!)^2, each odd prime p comes with the exponent sum of floor(n / p^i) mod 2, so p^e <= n
+BinaryData oddSwing(Limb n, const std::vector<Limb>& primes, size_t threads)
+{
+    std::vector<Limb> factors;
+    for(auto it = std::next(primes.cbegin()); it != primes.cend() && *it <= n; ++it)
+    {
+        const Limb prime = *it;
+        if(prime <= n / prime)
+        {
+            Limb power{1};
+            for(Limb quotient = n / prime; quotient > 0; quotient /= prime)
+                if(quotient & 1) power *= prime;
+            if(power > 1) factors.push_back(power);
+        }
+        else if((n / prime) & 1)
+        {
+            factors.push_back(prime);
+        }
+    }
+    return product(factors, threads);
+}
+
+// odd part of n!, which is the square of the one of (n / 2)! times the odd swing of n
+BinaryData oddFactorial(Limb n, const std::vector<Limb>& primes, size_t threads)
+{
+    if(n < 3) return BinaryData{1};
+    const BinaryData half = oddFactorial(n / 2, primes, threads);
+    return Operation::multiplication(Operation::multiplication(half, half), oddSwing(n, primes, threads));
+}
+
+// Luschny's prime swing: n! is its odd part shifted by n - popcount(n), the exponent of 2
+BinaryData factorial(Limb n, size_t threads)
+{
+    BinaryData result = oddFactorial(n, primesUpTo(n, threads), threads);
+    Operation::leftShift(result, n - static_cast<Limb>(Operation::popCount(BinaryData{n})));
+    return result;
+}
+
+// n!! is 2^m m! for n = 2m and n! / (2^m m!) for n = 2m + 1, the odd case built from its prime exponents
+BinaryData doubleFactorial(Limb n, size_t threads)
+{
+    const Limb half = n / 2;
+    if(n % 2 == 0)
+    {
+        BinaryData result = factorial(half, threads);
+        Operation::leftShift(result, half);
+        return result;
+    }
+
+    std::vector<Limb> primes = primesUpTo(n, threads), exponents;
+    if(!primes.empty()) primes.erase(primes.begin());
+    for(Limb prime : primes)
+        exponents.push_back(legendre(n, prime) - legendre(half, prime));
+    return powerProduct(primes, exponents, threads);
+}
+
+// n choose k from the exponents of Legendre's formula, each prime power is at most n so the factors fit limbs
+BinaryData binomial(Limb n, Limb k, size_t threads)
+{
+    if(k > n) return BinaryData{0};
+    k = std::min(k, n - k);
+    if(k == 0) return BinaryData{1};
+
+    if(k < n / DirectBinomialRatio)
+    {
+        std::vector<Limb> factors(k);
+        std::iota(factors.begin(), factors.end(), n - k + 1);
+        return Operation::division(product(factors, threads), factorial(k, threads)).quotient;
+    }
+
+    std::vector<Limb> factors;
+    for(Limb prime : primesUpTo(n, threads))
+    {
+        const Limb exponent = legendre(n, prime) - legendre(k, prime) - legendre(n - k, prime);
+        Limb power{1};
+        for(Limb i{0}; i < exponent; ++i) power *= prime;
+        if(power > 1) factors.push_back(power);
+    }
+    return product(factors, threads);
+}
+
+// the product of the primes up to n
+BinaryData primorial(Limb n, size_t threads)
+{
+    return product(primesUpTo(n, threads), threads);
+}
+
+} // namespace Combinatorics
+
+namespace Converter
+{
+
+struct Validator
+{
+    template<class T>
+    bool operator()(T&& value)
+    {
+        return isValid(std::forward<T>(value));
+    }
+
+private:
+
+    static constexpr const char min = '0';
+    static constexpr const char max = '9';
+
+    bool isValid(const std::string& number)
+    {
+        auto it = *number.cbegin() == '-' ? std::next(number.cbegin()) : number.cbegin();
+        auto validate = [min=min, max=max](const char& symbol) -> bool { return symbol >= min && symbol <= max; };
+        return std::all_of(it, number.cend(), validate);
+    }
+
+    template< class T >
+    bool isValid(T&&) { return true; }
+
+} validator;
+
+// 10^19, the largest power of ten that fits into a limb
+constexpr const Limb DecimalChunk = 10000000000000000000ULL;
+constexpr const size_t DecimalChunkDigits = 19;
+
+// numbers shorter than this (in limbs or chunks) are converted chunk by chunk, longer ones are split by a power of the base
+constexpr const size_t RadixSplitThreshold = 32;
+
+/**
+ *  10^(19 * 2^index), each power is the square of the previous one and is kept for later conversions
+ */
+const BinaryData& decimalPower(size_t index)
+{
+    static std::deque<BinaryData> powers{BinaryData{DecimalChunk}};
+    static std::mutex guard;
+    std::lock_guard<std::mutex> lock(guard);
+    while(powers.size() <= index)
+        powers.push_back(Operation::multiplication(powers.back(), powers.back()));
+    return powers[index];
+}
+
+/**
+ *  FromBinary convert BinaryData to container for set base
+ */
+class FromBinary
+{
+    constexpr static const size_t m_binaryDigitBits = 1;
+    constexpr static const size_t m_octalDigitBits = 3;
+    constexpr static const size_t m_hexDigitBits = 4;
+
+    template<class T>
+    static char toChar(const T& number) { return number+'0'; };
+
+    /**
+     *  Appends the digits of number, left-padded with zeros to width; zero with no width appends nothing.
+     *  Long numbers are split as high * 10^(19 * 2^k) + low with the power about the square root of the number.
+     */
+    static void appendDecimal(std::string& result, const BinaryData& number, size_t width)
+    {
+        if(number.size() < RadixSplitThreshold)
+            return appendDecimalChunks(result, number, width);
+
+        size_t index{0};
+        while(2 * decimalPower(index + 1).size() <= number.size() + 1)
+            ++index;
+
+        const size_t lowDigits = DecimalChunkDigits << index;
+        Operation::Division::Result parts = Operation::division(number, decimalPower(index));
+        appendDecimal(result, parts.quotient, width > lowDigits ? width - lowDigits : 0);
+        appendDecimal(result, parts.remainder, lowDigits);
+    }
+
+    static void appendDecimalChunks(std::string& result, BinaryData number, size_t width)
+    {
+        std::vector<Limb> chunks;
+        chunks.reserve(number.size() + 1);
+        while(!Operation::isZero(number))
+        {
+            chunks.push_back(Operation::divRemLimb(number.data(), number.data(), number.size(), DecimalChunk));
+            Operation::removeInsignificantBits(number);
+        }
+
+        char digits[DecimalChunkDigits];
+        auto toDigits = [&digits](Limb chunk)
+        {
+            for(size_t i = DecimalChunkDigits; i-- > 0; chunk /= 10)
+                digits[i] = toChar(chunk % 10);
+        };
+
+        size_t length = chunks.empty() ? 0 : DecimalChunkDigits * (chunks.size() - 1);
+        size_t skip{0};
+        if(!chunks.empty())
+        {
+            toDigits(chunks.back());
+            while(skip + 1 < DecimalChunkDigits && digits[skip] == '0') ++skip;
+            length += DecimalChunkDigits - skip;
+        }
+
+        if(width > length) result.append(width - length, '0');
+        if(chunks.empty()) return;
+
+        result.append(digits + skip, digits + DecimalChunkDigits);
+        for(size_t i = chunks.size() - 1; i-- > 0;)
+        {
+            toDigits(chunks[i]);
+            result.append(digits, digits + DecimalChunkDigits);
+        }
+    }
+
+    /**
+     *  Writes the low bitCount bits of number as digits of bitsPerDigit bits, most significant first,
+     *  into the end of result; every digit is read straight from the limbs
+     */
+    static void writeDigits(std::string& result, LimbSpan number, size_t bitCount, size_t bitsPerDigit, bool uppercase)
+    {
+        const char* alphabet = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+        const Limb mask = (Limb{1} << bitsPerDigit) - 1;
+        const size_t digits = (bitCount + bitsPerDigit - 1) / bitsPerDigit;
+        char* out = &result[result.size() - digits];
+
+        if(LimbBits % bitsPerDigit == 0)
+        {
+            // digits never straddle limbs: walk each limb from its low end
+            const size_t perLimb = LimbBits / bitsPerDigit;
+            for(size_t digit{0}, index{0}; digit < digits; ++index)
+            {
+                Limb limb = number[index];
+                for(size_t i{0}; i < perLimb && digit < digits; ++i, ++digit, limb >>= bitsPerDigit)
+                    out[digits - 1 - digit] = alphabet[limb & mask];
+            }
+            return;
+        }
+
+        for(size_t digit{0}; digit < digits; ++digit)
+        {
+            const size_t position = digit * bitsPerDigit;
+            const size_t index = position / LimbBits;
+            const size_t offset = position % LimbBits;
+            Limb value = number[index] >> offset;
+            if(offset + bitsPerDigit > LimbBits && index + 1 < number.size())
+                value |= number[index + 1] << (LimbBits - offset);
+            out[digits - 1 - digit] = alphabet[value & mask];
+        }
+    }
+
+    // sign, prefix and the digits of the magnitude in a power-of-two base
+    static std::string toPowerOfTwoBase(LimbSpan binary, Sign sign, size_t bitsPerDigit, const char* prefix, bool uppercase)
+    {
+        const size_t digits = (Operation::bitLength(binary) + bitsPerDigit - 1) / bitsPerDigit;
+        std::string result(sign == Sign::Negative ? "-" : "");
+        result += prefix;
+        result.resize(result.size() + digits);
+        writeDigits(result, binary, digits * bitsPerDigit, bitsPerDigit, uppercase);
+        return result;
+    }
+
+public:
+    /**
+     *  Negative numbers are written in two's complement over the bit length of the magnitude, after a leading 1
+     */
+    static std::string ToBinary(const BinaryData& binary, Sign sign, bool prefix = false)
+    {
+        if(sign == Sign::Positive)
+            return toPowerOfTwoBase(binary, sign, m_binaryDigitBits, prefix ? "0b" : "", false);
+
+        const size_t bits = Operation::bitLength(binary);
+        BinaryData complement = binary;
+        for(Limb& limb : complement)
+            limb = ~limb;
+        for(Limb& limb : complement)
+            if(++limb != 0) break;
+
+        std::string result(prefix ? "0b1" : "1");
+        result.resize(result.size() + bits);
+        writeDigits(result, complement, bits, m_binaryDigitBits, false);
+        return result;
+    }
+
+    static std::string ToOctal(const BinaryData& binary, Sign sign = Sign::Positive, bool prefix = false)
+    {
+        return toPowerOfTwoBase(binary, sign, m_octalDigitBits, prefix ? "0o" : "", false);
+    }
+
+    static std::string ToDecimal(const BinaryData& binary)
+    {
+        if(Operation::isZero(binary)) return "0";
+
+        std::string result;
+        result.reserve(static_cast<size_t>(static_cast<double>(Operation::bitLength(binary)) * 0.30103) + 1);
+        appendDecimal(result, binary, 0);
+        return result;
+    }
+
+    template<class T>
+    static T toInt(const BinaryData& binary)
+    {
+        return static_cast<T>(binary[0]);
+    }
+
+    static std::string ToHex(LimbSpan binary, Sign sign = Sign::Positive, bool uppercase = true, bool prefix = false)
+    {
+        return toPowerOfTwoBase(binary, sign, m_hexDigitBits, prefix ? "0x" : "", uppercase);
+    }
+
+};
+
+/**
+ *   ToBinary convert any collection to binary format
+ */
+class ToBinary
+{
+    // digit value in bases up to 36, anything else maps past every base
+    static unsigned digitValue(char symbol) noexcept
+    {
+        if(symbol >= '0' && symbol <= '9') return static_cast<unsigned>(symbol - '0');
+        if(symbol >= 'a' && symbol <= 'z') return static_cast<unsigned>(symbol - 'a') + 10;
+        if(symbol >= 'A' && symbol <= 'Z') return static_cast<unsigned>(symbol - 'A') + 10;
+        return std::numeric_limits<unsigned>::max();
+    }
+
+    /**
+     *  Value of the digits [digits, digits + count) in base, read chunkDigits at a time.
+     *  Long inputs are split as high * base^(chunkDigits * 2^k) + low, the low part taking
+     *  the largest such power below count digits; power(k) supplies base^(chunkDigits * 2^k).
+     */
+    template<class Powers>
+    static BinaryData parseRadix(const char* digits, size_t count, Limb base, size_t chunkDigits, Powers&& power)
+    {
+        if(count <= chunkDigits * RadixSplitThreshold)
+            return parseChunks(digits, count, base, chunkDigits);
+
+        size_t index{0};
+        while((chunkDigits << (index + 1)) < count)
+            ++index;
+
+        const size_t lowDigits = chunkDigits << index;
+        const BinaryData high = parseRadix(digits, count - lowDigits, base, chunkDigits, power);
+        const BinaryData low = parseRadix(digits + count - lowDigits, lowDigits, base, chunkDigits, power);
+        return Operation::addition(Operation::multiplication(high, power(index)), low);
+    }
+
+    // multiply-and-add one chunk of up to chunkDigits digits at a time
+    static BinaryData parseChunks(const char* digits, size_t count, Limb base, size_t chunkDigits)
+    {
+        BinaryData result{0};
+        result.reserve(count / chunkDigits + 1);
+        for(size_t length = count % chunkDigits == 0 ? chunkDigits : count % chunkDigits;
+            count != 0; count -= length, length = chunkDigits)
+        {
+            Limb chunk{0};
+            Limb scale{1};
+            for(const char* it = digits; it != digits + length; ++it)
+            {
+                chunk = chunk * base + digitValue(*it);
+                scale *= base;
+            }
+            digits += length;
+
+            if(Limb carry = Operation::mulLimb(result.data(), result.data(), result.size(), scale); carry != 0)
+                result.push_back(carry);
+            Operation::addLimb(result, chunk);
+        }
+
+        Operation::removeInsignificantBits(result);
+        return result;
+    }
+
+    // bases 2, 4, 8, 16 and 32: every digit is a fixed group of bits
+    static BinaryData packBits(const char* digits, size_t count, size_t bitsPerDigit)
+    {
+        BinaryData result((count * bitsPerDigit + LimbBits - 1) / LimbBits, 0);
+        size_t position{0};
+        for(size_t i = count; i-- > 0; position += bitsPerDigit)
+        {
+            const Limb value = digitValue(digits[i]);
+            const size_t offset = position % LimbBits;
+            result[position / LimbBits] |= value << offset;
+            if(offset + bitsPerDigit > LimbBits)
+                result[position / LimbBits + 1] |= value >> (LimbBits - offset);
+        }
+
+        Operation::removeInsignificantBits(result);
+        return result;
+    }
+
+    static BinaryData parseDecimal(const char* digits, size_t count)
+    {
+        return parseRadix(digits, count, 10, DecimalChunkDigits, decimalPower);
+    }
+
+    static State fromDecimal(const std::string& number)
+    {
+        const size_t sign = !number.empty() && number.front() == '-' ? 1 : 0;
+        const size_t first = std::min(number.find_first_not_of('0', sign), number.size());
+        if(first == number.size()) return State();
+
+        BinaryData binary = parseDecimal(number.data() + first, number.size() - first);
+        return State(std::move(binary), sign == 1 ? Sign::Negative : Sign::Positive);
+    }
+
+    template<class T>
+    static State fromDecimal(T number)
+    {
+        static_assert(sizeof(T) <= sizeof(Limb), "integer must fit into one limb");
+        using Unsigned = std::make_unsigned_t<T>;
+        Unsigned magnitude = static_cast<Unsigned>(number);
+        Sign sign = Sign::Positive;
+        if constexpr(!is_unsigned<T>())
+        {
+            if(number < 0)
+            {
+                magnitude = static_cast<Unsigned>(0) - magnitude;
+                sign = Sign::Negative;
+            }
+        }
+
+        return State(BinaryData{ static_cast<Limb>(magnitude) }, sign);
+    }
+
+public:
+
+    /**
+     *  Parses an optionally signed number in base 2..36; base 0 means decimal unless the digits
+     *  start with a 0x, 0o or 0b prefix, which is also accepted when it matches the given base.
+     *  Malformed input gives zero like the decimal constructor.
+     */
+    static State fromString(std::string_view text, int base)
+    {
+        if(base != 0 && (base < 2 || base > 36)) throw "Invalid base";
+
+        Sign sign = Sign::Positive;
+        if(!text.empty() && (text.front() == '-' || text.front() == '+'))
+        {
+            if(text.front() == '-') sign = Sign::Negative;
+            text.remove_prefix(1);
+        }
+
+        if(text.size() > 2 && text[0] == '0')
+        {
+            const char marker = text[1];
+            const int prefixed = (marker == 'x' || marker == 'X') ? 16 :
+                                 (marker == 'o' || marker == 'O') ? 8 :
+                                 (marker == 'b' || marker == 'B') ? 2 : 0;
+            if(prefixed != 0 && (base == 0 || base == prefixed))
+            {
+                base = prefixed;
+                text.remove_prefix(2);
+            }
+        }
+
+        if(base == 0) base = 10;
+        const unsigned radix = static_cast<unsigned>(base);
+        if(text.empty() || !std::all_of(text.cbegin(), text.cend(), [radix](char symbol) { return digitValue(symbol) < radix; }))
+            return State();
+
+        text.remove_prefix(std::min(text.find_first_not_of('0'), text.size()));
+        if(text.empty()) return State();
+
+        BinaryData binary;
+        if((radix & (radix - 1)) == 0)
+        {
+            binary = packBits(text.data(), text.size(), Operation::countTrailingZeros(radix));
+        }
+        else if(radix == 10)
+        {
+            binary = parseDecimal(text.data(), text.size());
+        }
+        else
+        {
+            // the largest power of the base that fits into a limb is one chunk
+            size_t chunkDigits{1};
+            Limb chunk = radix;
+            while(chunk <= std::numeric_limits<Limb>::max() / radix)
+            {
+                chunk *= radix;
+                ++chunkDigits;
+            }
+
+            std::deque<BinaryData> powers{BinaryData{chunk}};
+            auto power = [&powers](size_t index) -> const BinaryData&
+            {
+                while(powers.size() <= index)
+                    powers.push_back(Operation::multiplication(powers.back(), powers.back()));
+                return powers[index];
+            };
+            binary = parseRadix(text.data(), text.size(), radix, chunkDigits, power);
+        }
+
+        return State(std::move(binary), sign);
+    }
+
+    template<class T>
+    static State convert(T&& value)
+    {
+        return validator(value) ? fromDecimal(value) : State();
+    }
+
+};
+
+/**
+ *  Bytes moves magnitudes and two's complement values between limbs and byte buffers
+ */
+class Bytes
+{
+    // little-endian byte index of the value, fill past the limbs
+    static uint8_t byteAt(const BinaryData& number, size_t index, uint8_t fill) noexcept
+    {
+        if(index / LimbBytes >= number.size()) return fill;
+        return static_cast<uint8_t>(number[index / LimbBytes] >> (CHAR_BIT * (index % LimbBytes)));
+    }
+
+    static void negate(BinaryData& number) noexcept
+    {
+        for(Limb& limb : number)
+            limb = ~limb;
+        for(Limb& limb : number)
+            if(++limb != 0) break;
+    }
+
+    // writes all size bytes, bytes past the limbs take fill
+    static void write(const BinaryData& number, uint8_t* data, size_t size, Endian endian, uint8_t fill)
+    {
+        const size_t available = std::min(size, number.size() * LimbBytes);
+        if(endian == Endian::Little)
+        {
+            if constexpr(LittleEndianHost)
+                std::memcpy(data, number.data(), available);
+            else
+                for(size_t i{0}; i < available; ++i) data[i] = byteAt(number, i, fill);
+            std::memset(data + available, fill, size - available);
+            return;
+        }
+
+        size_t i{0};
+        if constexpr(LittleEndianHost)
+        {
+            // whole limbs go byte-swapped
+            for(; i + LimbBytes <= available; i += LimbBytes)
+            {
+                const Limb swapped = __builtin_bswap64(number[i / LimbBytes]);
+                std::memcpy(data + size - i - LimbBytes, &swapped, LimbBytes);
+            }
+        }
+        for(; i < size; ++i)
+            data[size - 1 - i] = byteAt(number, i, fill);
+    }
+
+public:
+
+    // bytes needed for the magnitude, at least one
+    static size_t MagnitudeSize(const BinaryData& number) noexcept
+    {
+        return (Operation::bitLength(number) + CHAR_BIT - 1) / CHAR_BIT;
+    }
+
+    // bytes needed for the two's complement form, sign bit included
+    static size_t TwosComplementSize(const BinaryData& number, Sign sign) noexcept
+    {
+        const size_t bits = Operation::bitLength(number);
+        const bool exactPower = Operation::popCount(number) == 1;
+        const size_t signedBits = sign == Sign::Negative && exactPower ? bits : bits + 1;
+        return (signedBits + CHAR_BIT - 1) / CHAR_BIT;
+    }
+
+    // magnitude zero-padded to size bytes
+    static void ToBytes(const BinaryData& number, uint8_t* data, size_t size, Endian endian)
+    {
+        if(MagnitudeSize(number) > size) throw "Buffer is too small";
+        write(number, data, size, endian, 0);
+    }
+
+    // two's complement sign-extended to size bytes
+    static void ToTwosComplement(const BinaryData& number, Sign sign, uint8_t* data, size_t size, Endian endian)
+    {
+        if(TwosComplementSize(number, sign) > size) throw "Buffer is too small";
+        if(sign == Sign::Positive)
+            return write(number, data, size, endian, 0);
+
+        BinaryData complement = number;
+        negate(complement);
+        write(complement, data, size, endian, 0xFF);
+    }
+
+    static State FromBytes(const uint8_t* data, size_t size, Endian endian, Signedness signedness)
+    {
+        if(size == 0) return State();
+
+        BinaryData number((size + LimbBytes - 1) / LimbBytes, 0);
+        if(endian == Endian::Little && LittleEndianHost)
+        {
+            std::memcpy(number.data(), data, size);
+        }
+        else
+        {
+            for(size_t i{0}; i < size; ++i)
+            {
+                const Limb byte = endian == Endian::Little ? data[i] : data[size - 1 - i];
+                number[i / LimbBytes] |= byte << (CHAR_BIT * (i % LimbBytes));
+            }
+        }
+
+        const uint8_t top = endian == Endian::Little ? data[size - 1] : data[0];
+        if(signedness == Signedness::Unsigned || (top & 0x80) == 0)
+        {
+            Operation::removeInsignificantBits(number);
+            return State(std::move(number));
+        }
+
+        // the magnitude of a negative value is 2^(8 * size) - bytes
+        negate(number);
+        if(const size_t used = (size % LimbBytes) * CHAR_BIT; used != 0)
+            number.back() &= (Limb{1} << used) - 1;
+        Operation::removeInsignificantBits(number);
+        return State(std::move(number), Sign::Negative);
+    }
+};
+
+/**
+ *  Binary archive format, version 1.
+ *  The archive opens with an 8-byte header: "BIGN", the version byte and three reserved zero bytes.
+ *  Each value follows as a LEB128 varint of (limb count << 1 | negative), zero padding up to
+ *  the next multiple of 8 bytes from the start of the archive and the normalized limbs in little endian.
+ *  The padding keeps the limbs aligned, so a mapped archive can be read in place.
+ */
+struct Record
+{
+    static constexpr const uint8_t Version = 1;
+    static constexpr const size_t HeaderSize = 8;
+    static constexpr const size_t MaxVarintSize = 10;
+    static constexpr const std::array<uint8_t, 4> Magic{'B', 'I', 'G', 'N'};
+
+    static void Header(uint8_t* data) noexcept
+    {
+        std::copy(Magic.cbegin(), Magic.cend(), data);
+        data[Magic.size()] = Version;
+        std::fill(data + Magic.size() + 1, data + HeaderSize, 0);
+    }
+
+    static void CheckHeader(const uint8_t* data)
+    {
+        if(!std::equal(Magic.cbegin(), Magic.cend(), data)) throw "Invalid format";
+        if(data[Magic.size()] == 0 || data[Magic.size()] > Version) throw "Unsupported version";
+    }
+
+    static size_t EncodeVarint(uint64_t value, uint8_t* data) noexcept
+    {
+        size_t size{0};
+        for(; value >= 0x80; value >>= 7)
+            data[size++] = static_cast<uint8_t>(value | 0x80);
+        data[size++] = static_cast<uint8_t>(value);
+        return size;
+    }
+
+    // @return bytes taken, 0 when the varint does not end within size bytes
+    static size_t DecodeVarint(const uint8_t* data, size_t size, uint64_t& value)
+    {
+        value = 0;
+        for(size_t i{0}; i < std::min(size, MaxVarintSize); ++i)
+        {
+            value |= static_cast<uint64_t>(data[i] & 0x7F) << (7 * i);
+            if((data[i] & 0x80) == 0)
+            {
+                if(i + 1 == MaxVarintSize && data[i] > 1) throw "Corrupted record";
+                return i + 1;
+            }
+        }
+        if(size >= MaxVarintSize) throw "Corrupted record";
+        return 0;
+    }
+
+    static uint64_t Tag(const BinaryData& number, Sign sign) noexcept
+    {
+        return static_cast<uint64_t>(number.size()) << 1 | (sign == Sign::Negative);
+    }
+
+    static size_t LimbCount(uint64_t tag)
+    {
+        const uint64_t count = tag >> 1;
+        if(count == 0 || count > std::numeric_limits<size_t>::max() / LimbBytes) throw "Corrupted record";
+        return static_cast<size_t>(count);
+    }
+
+    static Sign SignOf(uint64_t tag) noexcept { return (tag & 1) ? Sign::Negative : Sign::Positive; }
+
+    static size_t Padding(size_t offset) noexcept { return (LimbBytes - offset % LimbBytes) % LimbBytes; }
+
+    // rejects limbs that a writer could not have produced
+    static void CheckLimbs(const Limb* limbs, size_t size, Sign sign)
+    {
+        const bool zero = size == 1 && limbs[0] == 0;
+        if((size > 1 && limbs[size - 1] == 0) || (zero && sign == Sign::Negative)) throw "Corrupted record";
+    }
+};
+
+} // namespace Converter
+
+
+} // namespace
+
+
+
+namespace BigInt
+{
+
+class BigIntReader;
+class BigIntView;
+class ModContext;
+
+class BigInt final
+{
+    friend class BigIntReader;
+    friend class BigIntView;
+    friend class ModContext;
+
+    template<class T, class Callback>
+    static BinaryData process (const T& smaller, const T& bigger, Callback&& callback)
+    {
+        BinaryData result(bigger.size());
+        std::transform(smaller.cbegin(), smaller.cend(), bigger.cbegin(), result.begin(), callback);
+
+        size_t size = smaller.size();
+        std::transform(std::next(bigger.cbegin(), size), bigger.cend(), std::next(result.begin(), size), [&](const Limb& limb)
+        {
+            return callback(0, limb);
+        });
+
+        Operation::removeInsignificantBits(result);
+        return result;
+    }
+
+    template<class T, class Callback>
+    static BinaryData conditionForProcess (const T& lhs, const T& rhs, Callback&& callback)
+    {
+        return lhs.Number().size() <= rhs.Number().size() ?
+                        process(lhs.Number(), rhs.Number(), callback) :
+                        process(rhs.Number(), lhs.Number(), callback);
+    }
+
+    template<class Callback>
+    static BigInt Transform(const BigInt& lhs, const BigInt& rhs, Callback&& callback)
+    {
+        BinaryData result = conditionForProcess(lhs.isNegative() ? ~lhs : lhs,
+                                                rhs.isNegative() ? ~rhs : rhs, callback);
+        return lhs.sign() == rhs.sign() ? BigInt(std::move(result)) : ~(BigInt(std::move(result)));
+    }
+
+    State m_state;
+
+    BigInt(BinaryData number, Sign sign = Sign::Positive):
+        m_state(std::move(number), sign)
+    {}
+
+    BigInt(const State& state):
+        m_state{state}
+    {}
+
+    // magnitude and sign of a native integer, so mixed operations never build a BigInt for it
+    template<class T>
+    static constexpr Limb magnitudeOf(T value) noexcept
+    {
+        if constexpr(!is_unsigned<T>())
+        {
+            if(value < 0) return Limb{0} - static_cast<Limb>(value);
+        }
+        return static_cast<Limb>(value);
+    }
+
+    template<class T>
+    static constexpr Sign signOf(T value) noexcept
+    {
+        if constexpr(!is_unsigned<T>())
+        {
+            if(value < 0) return Sign::Negative;
+        }
+        return Sign::Positive;
+    }
+
+    // *this += (sign) magnitude
+    void addWord(Limb magnitude, Sign sign)
+    {
+        if(magnitude == 0) return;
+
+        BinaryData& number = m_state.number;
+        if(sign == m_state.sign || isZero())
+        {
+            Operation::addLimb(number, magnitude);
+            m_state.sign = sign;
+        }
+        else if(Operation::compare(number, magnitude) >= 0)
+        {
+            Operation::subLimb(number, magnitude);
+            if(isZero()) m_state.sign = Sign::Positive;
+        }
+        else
+        {
+            number.front() = magnitude - number.front();
+            m_state.sign = sign;
+        }
+    }
+
+    // three-way comparison with (sign) magnitude
+    int compareWord(Limb magnitude, Sign sign) const noexcept
+    {
+        if(magnitude == 0) sign = Sign::Positive;
+        if(m_state.sign != sign) return isNegative() ? -1 : 1;
+        const int order = Operation::compare(m_state.number, magnitude);
+        return isNegative() ? -order : order;
+    }
+
+public:
+    BigInt():
+        m_state{State()}
+    {}
+
+    BigInt(const std::string value) :
+        m_state{ Converter::ToBinary::convert( value ) }
+    {}
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt(T value)
+        : m_state{ Converter::ToBinary::convert( value ) }
+    {}
+
+    /**
+     *  Parses text in base 2..36, base 0 detects a 0x, 0o or 0b prefix and defaults to decimal
+     */
+    static BigInt fromString(std::string_view text, int base = 0)
+    {
+        return BigInt(Converter::ToBinary::fromString(text, base));
+    }
+
+    using Tuning = Operation::Tuning;
+
+    /**
+     *  Algorithm thresholds shared by all operations, may be adjusted at runtime
+     */
+    static Tuning& tuning() { return Operation::tuning; }
+
+    /**
+     *  Picks the algorithm thresholds by timing them on the running machine
+     */
+    static Tuning calibrate() { return Operation::calibrate(); }
+
+    inline const BinaryData& Number() const { return m_state.number; }
+    inline size_t count() const { return Operation::popCount(m_state.number); }
+    inline size_t bit() const { return Operation::bitLength(m_state.number); }
+    inline Sign sign() const { return m_state.sign; }
+    inline bool is2Pow() const
+    {
+        const BinaryData& number = Number();
+        return (number.back() & (number.back() - 1)) == 0 && number.back() != 0 &&
+                std::all_of(number.cbegin(), std::prev(number.cend()), [](const Limb& limb) { return limb == 0; });
+    }
+    /**
+     *  Exact below 2^64; above it Baillie-PSW, which has no known counterexample
+     */
+    bool isPrime() const { return isProbablePrime(); }
+
+    /**
+     *  Trial division by the primes below 1024, then deterministic Miller-Rabin below 2^64
+     *  and Baillie-PSW plus rounds Miller-Rabin tests to pseudo-random bases above
+     */
+    bool isProbablePrime(size_t rounds = 0) const
+    {
+        return isPositive() && Primality::isProbablePrime(Number(), rounds);
+    }
+    inline bool isPositive() const { return m_state.sign == Sign::Positive; }
+    inline bool isNegative() const { return !isPositive(); }
+    inline bool isEven() const { return (Number().front() & 1) == 0; }
+    inline bool isOdd() const { return !isEven(); }
+    inline bool isZero() const { return Operation::isZero(Number()); }
+    inline bool isUnit() const { return Number().size() == 1 && Number().front() == 1; }
+    inline void MakePositive() { m_state.sign = Sign::Positive; }
+    inline void MakeNegative() { if(!isZero()) m_state.sign = Sign::Negative; }
+    /**
+     *  Writes the magnitude into all size bytes, zero-padded; throws if it needs more than size bytes.
+     *  Little endian on a little-endian host is a plain copy of the limbs.
+     *  @return the number of significant bytes
+     */
+    size_t toBytes(uint8_t* data, size_t size, Endian endian = Endian::Little) const
+    {
+        Converter::Bytes::ToBytes(Number(), data, size, endian);
+        return Converter::Bytes::MagnitudeSize(Number());
+    }
+
+    // the magnitude in as few bytes as it needs
+    std::vector<uint8_t> toBytes(Endian endian = Endian::Little) const
+    {
+        std::vector<uint8_t> bytes(Converter::Bytes::MagnitudeSize(Number()));
+        Converter::Bytes::ToBytes(Number(), bytes.data(), bytes.size(), endian);
+        return bytes;
+    }
+
+    /**
+     *  Writes the two's complement form sign-extended to size bytes; throws if it needs more than size bytes.
+     *  @return the number of bytes the shortest form needs
+     */
+    size_t toTwosComplementBytes(uint8_t* data, size_t size, Endian endian = Endian::Little) const
+    {
+        Converter::Bytes::ToTwosComplement(Number(), sign(), data, size, endian);
+        return Converter::Bytes::TwosComplementSize(Number(), sign());
+    }
+
+    // the shortest two's complement form
+    std::vector<uint8_t> toTwosComplementBytes(Endian endian = Endian::Little) const
+    {
+        std::vector<uint8_t> bytes(Converter::Bytes::TwosComplementSize(Number(), sign()));
+        Converter::Bytes::ToTwosComplement(Number(), sign(), bytes.data(), bytes.size(), endian);
+        return bytes;
+    }
+
+    /**
+     *  Reads size bytes as a magnitude, or as two's complement when signedness is Signed
+     */
+    static BigInt fromBytes(const uint8_t* data, size_t size, Endian endian = Endian::Little,
+                            Signedness signedness = Signedness::Unsigned)
+    {
+        return BigInt(Converter::Bytes::FromBytes(data, size, endian, signedness));
+    }
+
+    static BigInt fromBytes(const std::vector<uint8_t>& bytes, Endian endian = Endian::Little,
+                            Signedness signedness = Signedness::Unsigned)
+    {
+        return fromBytes(bytes.data(), bytes.size(), endian, signedness);
+    }
+
+    /**
+     *  Negative numbers come out in two's complement after a leading 1, prefix adds 0b
+     */
+    inline std::string toBinary(bool prefix = false) const
+    {
+        return Converter::FromBinary::ToBinary(m_state.number, m_state.sign, prefix);
+    }
+    inline std::string toOctal(bool prefix = false) const
+    {
+        return Converter::FromBinary::ToOctal(m_state.number, m_state.sign, prefix);
+    }
+    inline std::string toDecimal() const
+    {
+        return isNegative() ? '-' + Converter::FromBinary::ToDecimal(m_state.number)
+                            : Converter::FromBinary::ToDecimal(m_state.number);
+    }
+    inline std::string toHex(bool uppercase = true, bool prefix = false) const
+    {
+        return Converter::FromBinary::ToHex(m_state.number, m_state.sign, uppercase, prefix);
+    }
+
+    friend BigInt operator + (const BigInt& lhs, const BigInt& rhs)
+    {
+        if(lhs.sign() == rhs.sign())
+            return BigInt(Operation::addition(lhs.Number(), rhs.Number()), lhs.sign());
+
+        if(Operation::less(lhs.Number(), rhs.Number()))
+            return BigInt(Operation::subtraction(rhs.Number(), lhs.Number()), rhs.sign());
+
+        return BigInt(Operation::subtraction(lhs.Number(), rhs.Number()), lhs.sign());
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator + (BigInt lhs, T rhs)
+    {
+        return lhs += rhs;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator + (T lhs, BigInt rhs)
+    {
+        return rhs += lhs;
+    }
+
+    BigInt& operator += (const BigInt& other)
+    {
+        *this = operator+(*this, other);
+        return *this;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt& operator += (T other)
+    {
+        addWord(magnitudeOf(other), signOf(other));
+        return *this;
+    }
+
+    friend BigInt operator - (const BigInt& lhs, const BigInt& rhs)
+    {
+        if(lhs.sign() != rhs.sign())
+            return BigInt(Operation::addition(lhs.Number(), rhs.Number()), lhs.sign());
+
+        bool isBigger = Operation::greater(lhs.Number(), rhs.Number());
+        Sign sign = lhs.isNegative() ?
+                    (isBigger ? Sign::Negative : Sign::Positive) :
+                    (isBigger ? Sign::Positive : Sign::Negative);
+        BinaryData result = isBigger ?
+                Operation::subtraction(lhs.Number(), rhs.Number()) :
+                Operation::subtraction(rhs.Number(), lhs.Number());
+
+        return BigInt(std::move(result), sign);
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator - (BigInt lhs, T rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator - (T lhs, const BigInt& rhs)
+    {
+        BigInt result = -rhs;
+        return result += lhs;
+    }
+
+    BigInt& operator -= (const BigInt& other)
+    {
+        *this = operator-(*this, other);
+        return *this;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt& operator -= (T other)
+    {
+        addWord(magnitudeOf(other), signOf(other) == Sign::Positive ? Sign::Negative : Sign::Positive);
+        return *this;
+    }
+
+    /**
+     *  Squaring needs roughly half the partial products of a general multiplication
+     */
+    BigInt square() const
+    {
+        return BigInt(Operation::multiplication(Number(), Number()));
+    }
+
+    static BigInt sqr(const BigInt& number) { return number.square(); }
+
+    friend BigInt operator * (const BigInt& lhs, const BigInt& rhs)
+    {
+        if(lhs.isZero() || rhs.isZero()) return BigInt();
+        Sign sign = lhs.sign() == rhs.sign() ? Sign::Positive : Sign::Negative;
+        if(lhs.isUnit()) return BigInt(rhs.Number(), sign);
+        if(rhs.isUnit()) return BigInt(lhs.Number(), sign);
+        if(lhs.is2Pow()) return BigInt(rhs.Number(), sign) << lhs.bit()-1;
+        if(rhs.is2Pow()) return BigInt(lhs.Number(), sign) << rhs.bit()-1;
+
+        return BigInt(Operation::multiplication(lhs.Number(), rhs.Number()), sign);
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator * (BigInt lhs, T rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator * (T lhs, BigInt rhs)
+    {
+        return rhs *= lhs;
+    }
+
+    BigInt& operator *= (const BigInt& other)
+    {
+        *this = operator*(*this, other);
+        return *this;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt& operator *= (T other)
+    {
+        const Limb multiplier = magnitudeOf(other);
+        if(multiplier == 0 || isZero())
+        {
+            *this = BigInt();
+            return *this;
+        }
+
+        BinaryData& number = m_state.number;
+        if(Limb carry = Operation::mulLimb(number.data(), number.data(), number.size(), multiplier); carry != 0)
+            number.push_back(carry);
+        if(signOf(other) == Sign::Negative) m_state.sign = isPositive() ? Sign::Negative : Sign::Positive;
+        return *this;
+    }
+
+    friend BigInt operator / (const BigInt& lhs, const BigInt& rhs)
+    {
+        return divmod(lhs, rhs).first;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator / (BigInt lhs, T rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator / (T lhs, const BigInt& rhs)
+    {
+        if(rhs.isZero()) throw "Division by zero";
+        const Limb dividend = magnitudeOf(lhs);
+        if(rhs.Number().size() > 1 || dividend < rhs.Number().front()) return BigInt();
+        return BigInt(BinaryData{dividend / rhs.Number().front()}, signOf(lhs) == rhs.sign() ? Sign::Positive : Sign::Negative);
+    }
+
+    BigInt& operator /= (const BigInt& other)
+    {
+        *this = operator/(*this, other);
+        return *this;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt& operator /= (T other)
+    {
+        const Limb divisor = magnitudeOf(other);
+        if(divisor == 0) throw "Division by zero";
+
+        BinaryData& number = m_state.number;
+        Operation::divRemLimb(number.data(), number.data(), number.size(), divisor);
+        Operation::removeInsignificantBits(number);
+        if(signOf(other) == Sign::Negative) m_state.sign = isPositive() ? Sign::Negative : Sign::Positive;
+        if(isZero()) m_state.sign = Sign::Positive;
+        return *this;
+    }
+
+    friend BigInt operator % (const BigInt& lhs, const BigInt& rhs)
+    {
+        if(rhs.isZero()) throw "Division by zero";
+        if(Operation::less(lhs.Number(), rhs.Number())) return lhs;
+        return divmod(lhs, rhs).second;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator % (const BigInt& lhs, T rhs)
+    {
+        const Limb divisor = magnitudeOf(rhs);
+        if(divisor == 0) throw "Division by zero";
+        const Limb remainder = Operation::modLimb(lhs.Number().data(), lhs.Number().size(), divisor);
+        return BigInt(BinaryData{remainder}, lhs.sign());
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator % (T lhs, const BigInt& rhs)
+    {
+        if(rhs.isZero()) throw "Division by zero";
+        const Limb dividend = magnitudeOf(lhs);
+        const Limb remainder = rhs.Number().size() > 1 ? dividend : dividend % rhs.Number().front();
+        return BigInt(BinaryData{remainder}, signOf(lhs));
+    }
+
+    BigInt& operator %= (const BigInt& other)
+    {
+        *this = operator%(*this, other);
+        return *this;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt& operator %= (T other)
+    {
+        *this = operator%(*this, other);
+        return *this;
+    }
+
+    /**
+     *  Quotient and remainder of one division: the quotient is truncated toward zero,
+     *  the remainder takes the sign of the dividend
+     */
+    static std::pair<BigInt, BigInt> divmod(const BigInt& dividend, const BigInt& divisor)
+    {
+        if(divisor.isZero()) throw "Division by zero";
+        if(Operation::less(dividend.Number(), divisor.Number())) return {BigInt(), dividend};
+        Sign sign = dividend.sign() == divisor.sign() ? Sign::Positive : Sign::Negative;
+
+        if(divisor.is2Pow())
+        {
+            const size_t shift = divisor.bit() - 1;
+            BinaryData quotient = dividend.Number();
+            Operation::rightShift(quotient, shift);
+
+            BinaryData remainder(dividend.Number().cbegin(), std::next(dividend.Number().cbegin(), shift / LimbBits + 1));
+            if(shift % LimbBits != 0) remainder.back() &= (Limb(1) << (shift % LimbBits)) - 1;
+            else remainder.pop_back();
+            if(remainder.empty()) remainder.push_back(0);
+            Operation::removeInsignificantBits(remainder);
+
+            return {BigInt(std::move(quotient), sign), BigInt(std::move(remainder), dividend.sign())};
+        }
+
+        Operation::Division::Result result = Operation::division(dividend.Number(), divisor.Number());
+        return {BigInt(std::move(result.quotient), sign), BigInt(std::move(result.remainder), dividend.sign())};
+    }
+
+    /**
+     *  Replaces this number by the quotient and returns the remainder
+     */
+    BigInt divmod_assign(const BigInt& divisor)
+    {
+        std::pair<BigInt, BigInt> result = divmod(*this, divisor);
+        *this = std::move(result.first);
+        return std::move(result.second);
+    }
+
+    /**
+     *  Replaces this number by the quotient and stores the remainder into `remainder`
+     */
+    BigInt& divmod_assign(const BigInt& divisor, BigInt& remainder)
+    {
+        remainder = divmod_assign(divisor);
+        return *this;
+    }
+
+    friend bool operator < (const BigInt& lhs, const BigInt& rhs)
+    {
+        if(lhs.isPositive() && rhs.isNegative()) return false;
+        if(lhs.isNegative() && rhs.isPositive()) return true;
+        if(lhs.isNegative() && rhs.isNegative()) return Operation::greater(lhs.Number(), rhs.Number());
+        return Operation::less(lhs.Number(), rhs.Number());
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator < (const BigInt& lhs, T rhs)
+    {
+        return lhs.compareWord(magnitudeOf(rhs), signOf(rhs)) < 0;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator < (T lhs, const BigInt& rhs)
+    {
+        return 0 < rhs.compareWord(magnitudeOf(lhs), signOf(lhs));
+    }
+
+    friend bool operator <= (const BigInt& lhs, const BigInt& rhs)
+    {
+        return !operator <(rhs, lhs);
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator <= (const BigInt& lhs, T rhs)
+    {
+        return lhs.compareWord(magnitudeOf(rhs), signOf(rhs)) <= 0;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator <= (T lhs, const BigInt& rhs)
+    {
+        return 0 <= rhs.compareWord(magnitudeOf(lhs), signOf(lhs));
+    }
+
+    friend bool operator > (const BigInt& lhs, const BigInt& rhs)
+    {
+        return operator <(rhs, lhs);
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator > (const BigInt& lhs, T rhs)
+    {
+        return lhs.compareWord(magnitudeOf(rhs), signOf(rhs)) > 0;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator > (T lhs, const BigInt& rhs)
+    {
+        return 0 > rhs.compareWord(magnitudeOf(lhs), signOf(lhs));
+    }
+
+    friend bool operator >= (const BigInt& lhs, const BigInt& rhs)
+    {
+        return !operator <(lhs, rhs);
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator >= (const BigInt& lhs, T rhs)
+    {
+        return lhs.compareWord(magnitudeOf(rhs), signOf(rhs)) >= 0;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator >= (T lhs, const BigInt& rhs)
+    {
+        return 0 >= rhs.compareWord(magnitudeOf(lhs), signOf(lhs));
+    }
+
+    friend bool operator == (const BigInt& lhs, const BigInt& rhs)
+    {
+        if(lhs.sign() != rhs.sign()) return false;
+        return Operation::equal(lhs.Number(), rhs.Number());
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator == (const BigInt& lhs, T rhs)
+    {
+        return lhs.compareWord(magnitudeOf(rhs), signOf(rhs)) == 0;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator == (T lhs, const BigInt& rhs)
+    {
+        return 0 == rhs.compareWord(magnitudeOf(lhs), signOf(lhs));
+    }
+
+    friend bool operator != (const BigInt& lhs, const BigInt& rhs)
+    {
+        return !operator ==(lhs, rhs);
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator != (const BigInt& lhs, T rhs)
+    {
+        return lhs.compareWord(magnitudeOf(rhs), signOf(rhs)) != 0;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend bool operator != (T lhs, const BigInt& rhs)
+    {
+        return 0 != rhs.compareWord(magnitudeOf(lhs), signOf(lhs));
+    }
+
+    friend BigInt operator ^ (const BigInt& lhs, const BigInt& rhs)
+    {
+        return Transform(lhs, rhs, Operation::predicates['^']);
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator ^ (const BigInt& lhs, T rhs)
+    {
+        return operator^(lhs, BigInt(rhs));
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator ^ (T lhs, const BigInt& rhs)
+    {
+        return operator^(BigInt(lhs), rhs);
+    }
+
+    BigInt& operator ^= (const BigInt& other)
+    {
+        *this = Transform(*this, other, Operation::predicates['^']);
+        return *this;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt& operator ^= (T other)
+    {
+        return operator^=(BigInt(other));
+    }
+
+    friend BigInt operator | (const BigInt& lhs, const BigInt& rhs)
+    {
+        return Transform(lhs, rhs, Operation::predicates['|']);
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator | (const BigInt& lhs, T rhs)
+    {
+        return operator|(lhs, BigInt(rhs));
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator | (T lhs, const BigInt& rhs)
+    {
+        return operator|(BigInt(lhs), rhs);
+    }
+
+    BigInt& operator |= (const BigInt& other)
+    {
+        *this = Transform(*this, other, Operation::predicates['|']);
+        return *this;
+    }
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt& operator |= (T other)
+    {
+        return operator|=(BigInt(other));
+    }
+
+    friend BigInt operator & (const BigInt& lhs, const BigInt& rhs)
     {
-        bool notPrime = bit() == 1 && (isZero() || isUnit()); // 0,1
-        bool prime = !notPrime && bit() == 2 &&
-                ( Operation::equal(BinaryData({1,0}), Number()) || Operation::equal(BinaryData({1,1}), Number())) ;
-        if(notPrime) return false;
-        if(prime) return true;
-
-        if ( ( (pow(*this, 2)) % BigInt(BinaryData({1,1,0,0,0}), 2) ).isUnit())
-            return true;
+        return Transform(lhs, rhs, Operation::predicates['&']);
+    }
 
-        return false;
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator & (const BigInt& lhs, T rhs)
+    {
+        return operator&(lhs, BigInt(rhs));
     }
-    inline bool isPositive() const { return m_state.sign == Sign::Positive; }
-    inline bool isNegative() const { return !isPositive(); }
-    inline bool isEven() const { return *Number().rbegin() == 0; }
-    inline bool isOdd() const { return !isEven(); }
-    inline bool isZero() const { return bit() == 1 && *Number().begin() == 0; }
-    inline bool isUnit() const { return bit() == 1 && *Number().begin() == 1; }
-    inline void MakePositive() { m_state.sign = Sign::Positive; }
-    inline void MakeNegative() { m_state.sign = Sign::Negative; }
-    inline std::string toBinary() const { return Converter::FromBinary::ToBinary(m_state.number, m_state.sign); }
-    inline std::string toOctal() const
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    friend BigInt operator & (T lhs, const BigInt& rhs)
     {
-        return isNegative() ? '-' + Converter::FromBinary::ToOctal(m_state.number)
-                            : Converter::FromBinary::ToOctal(m_state.number);
+        return operator&(BigInt(lhs), rhs);
     }
-    inline std::string toDecimal() const
+
+    BigInt& operator &= (const BigInt& other)
     {
-        return isNegative() ? '-' + Converter::FromBinary::ToDecimal(m_state.number)
-                            : Converter::FromBinary::ToDecimal(m_state.number);
+        *this = Transform(*this, other, Operation::predicates['&']);
+        return *this;
     }
-    inline std::string toHex() const
+
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    BigInt& operator &= (T other)
     {
-        return  isNegative() ? '-' + Converter::FromBinary::ToHex(m_state.number)
-                             : Converter::FromBinary::ToHex(m_state.number);
+        return operator&=(BigInt(other));
     }
 
-    friend BigInt operator + (const BigInt& lhs, const BigInt& rhs)
+    friend BigInt operator ~(const BigInt& number)
     {
-        if( (lhs.isPositive() && rhs.isPositive()) ||
-                (lhs.isNegative() && rhs.isNegative()) )
-        {
-            auto [result, bits] = Operation::addition(lhs.Number(), rhs.Number());
-            return BigInt(result, bits, Sign::Positive);
-        }
-        if(lhs.isNegative())
-        {
-            if(Operation::less(lhs.Number(), rhs.Number()))
-            {
-                auto [result, bits] = Operation::subtraction(lhs.Number(), rhs.Number());
-                return BigInt(result, bits, Sign::Positive);
-            }
-            else
-            {
-                auto [result, bits] = Operation::subtraction(rhs.Number(), lhs.Number());
-                return BigInt(result, bits, Sign::Negative);
-            }
-        } else if(rhs.isNegative())
+        if(number.isZero())
+            return BigInt(BinaryData{1}, Sign::Negative);
+
+        BinaryData data = number.Number();
+        if(number.isPositive())
         {
-            if(Operation::less(rhs.Number(), lhs.Number()))
-            {
-                auto [result, bits] = Operation::subtraction(lhs.Number(), rhs.Number());
-                return BigInt(result, bits, Sign::Positive);
-            }
-            else
-            {
-                auto [result, bits] = Operation::subtraction(rhs.Number(), lhs.Number());
-                return BigInt(result, bits, Sign::Negative);
-            }
+            Operation::Increment(data);
+            return BigInt(std::move(data), Sign::Negative);
         }
 
-        return BigInt();
+        Operation::Decrement(data);
+        return BigInt(std::move(data), Sign::Positive);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator + (const BigInt& lhs, T rhs)
+    friend BigInt operator -(const BigInt& number)
     {
-        return operator+(lhs, BigInt(rhs));
+        return BigInt(number.Number(), number.isPositive() ? Sign::Negative : Sign::Positive);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator + (T lhs, const BigInt& rhs)
+    BigInt operator !()
     {
-        return operator+(BigInt(lhs), rhs);
+        return isZero() ? BigInt(BinaryData{1}, Sign::Positive) : BigInt();
     }
 
-    BigInt& operator += (const BigInt& other)
+    friend BigInt operator << (const BigInt& lhs, const size_t offset)
     {
-        *this = operator+(*this, other);
-        return *this;
+        BinaryData newResult = lhs.Number();
+        Operation::leftShift(newResult, offset);
+        return BigInt(std::move(newResult), lhs.sign());
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    BigInt& operator += (T other)
+    BigInt& operator <<= (const size_t offset)
     {
-        *this = operator+(*this, BigInt(other));
+        Operation::leftShift(m_state.number, offset);
         return *this;
     }
 
-    friend BigInt operator - (const BigInt& lhs, const BigInt& rhs)
+    friend BigInt operator >> (const BigInt& lhs, const size_t offset)
     {
-        if(lhs.isPositive() && rhs.isNegative())
-        {
-            auto [result, bits] = Operation::addition(lhs.Number(), rhs.Number());
-            return BigInt(result, bits, Sign::Positive);
-        }
-        else if(lhs.isNegative() && rhs.isPositive())
-        {
-            auto [result, bits] = Operation::addition(lhs.Number(), rhs.Number());
-            return BigInt(result, bits, Sign::Negative);
-        }
-
-        bool isBigger = Operation::greater(lhs.Number(), rhs.Number());
-        Sign sign = (lhs.isNegative() && rhs.isNegative()) ?
-                    (isBigger ? Sign::Negative : Sign::Positive) :
-                    (isBigger ? Sign::Positive : Sign::Negative);
-        auto [result, bits] = isBigger ?
-                Operation::subtraction(lhs.Number(), rhs.Number()) :
-                Operation::subtraction(rhs.Number(), lhs.Number());
+        BinaryData newResult = lhs.Number();
+        Operation::rightShift(newResult, offset);
+        return BigInt(std::move(newResult), lhs.sign());
+    }
 
-        return BigInt(result, bits, sign);
+    BigInt& operator >>= (const size_t offset)
+    {
+        Operation::rightShift(m_state.number, offset);
+        if(isZero()) MakePositive();
+        return *this;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator - (const BigInt& lhs, T rhs)
+    friend std::ostream& operator << (std::ostream& os, const BigInt& number)
     {
-        return operator-(lhs, BigInt(rhs));
+        os << number.toDecimal();
+        return os;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator - (T lhs, const BigInt& rhs)
+    friend std::istream& operator >> (std::istream& is, BigInt& number)
     {
-        return operator-(BigInt(lhs), rhs);
+        std::string str;
+        is >> str;
+        number = str;
+        return is;
     }
 
-    BigInt& operator -= (const BigInt& other)
+    BigInt& operator++()
     {
-        *this = operator-(*this, other);
+        if(isNegative())
+        {
+            Operation::Decrement(m_state.number);
+            if(isZero()) MakePositive();
+        }
+        else Operation::Increment(m_state.number);
+
         return *this;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    BigInt& operator -= (T other)
+    BigInt& operator--()
     {
-        *this = operator-(*this, BigInt(toBinary(other)));
+        if(isZero())
+            *this = BigInt(BinaryData{1}, Sign::Negative);
+        else if(isPositive())
+            Operation::Decrement(m_state.number);
+        else if(isNegative())
+            Operation::Increment(m_state.number);
+
         return *this;
     }
 
-    friend BigInt operator * (const BigInt& lhs, const BigInt& rhs)
+    BigInt operator++(int)
     {
-        if(lhs.isZero() || rhs.isZero()) return BigInt();
-        Sign sign = lhs.sign() == rhs.sign() ? Sign::Positive : Sign::Negative;
-        if(lhs.isUnit()) return rhs;
-        if(rhs.isUnit()) return lhs;
-        if(lhs.is2Pow()) return rhs << lhs.bit()-1;
-        if(rhs.is2Pow()) return lhs << rhs.bit()-1;
+        auto tmp = *this;
+        operator++();
+        return tmp;
+    }
 
-        auto[result, bits] = Operation::multiplication(lhs.Number(), rhs.Number());
-        return BigInt(result, bits, sign);
+    BigInt operator--(int)
+    {
+        auto tmp = *this;
+        operator--();
+        return tmp;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator * (const BigInt& lhs, T rhs)
+    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
+    explicit operator T()
     {
-        return operator*(lhs, BigInt(rhs));
+        if(isNegative() && is_unsigned<T>()) return 0;
+
+        const size_t lenght = sizeof(T) * CHAR_BIT;
+        const size_t valueBits = is_unsigned<T>() ? lenght : lenght - 1;
+        const bool condition = isNegative() && bit() == lenght && is2Pow();
+
+        if(bit() <= valueBits || condition)
+        {
+            using Unsigned = std::make_unsigned_t<T>;
+            Unsigned magnitude = Converter::FromBinary::toInt<Unsigned>(Number());
+            return static_cast<T>(isNegative() ? static_cast<Unsigned>(0) - magnitude : magnitude);
+        }
+
+        return 0;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator * (T lhs, const BigInt& rhs)
+    static BigInt abs(const BigInt& number)
     {
-        return operator*(BigInt(lhs), rhs);
+        return number.isNegative() ? BigInt(number.Number(), Sign::Positive)
+                                   : number;
     }
 
-    BigInt& operator *= (const BigInt& other)
+    static BigInt pow(const BigInt& number, size_t pow)
     {
-        *this = operator*(*this, other);
-        return *this;
+        if(pow == 0) return BigInt(1);
+
+        // left to right: the running result is squared, the multiplier stays small
+        BigInt result = number;
+        for(size_t bit = LimbBits - 1 - Operation::countLeadingZeros(pow); bit-- > 0;)
+        {
+            result = result.square();
+            if((pow >> bit) & 1) result *= number;
+        }
+
+        return result;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    BigInt& operator *= (T other)
+    /**
+     *  base^exponent mod |modulus| in [0, |modulus|); intermediates never grow past twice the modulus.
+     *  Odd moduli use Montgomery multiplication, even ones Barrett reduction, the exponent is scanned in sliding windows.
+     */
+    static BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus)
     {
-        *this = operator*(*this, BigInt(toBinary(other)));
-        return *this;
+        if(modulus.isZero()) throw "Division by zero";
+        if(exponent.isNegative()) throw "Negative exponent";
+        if(modulus.isUnit()) return BigInt();
+
+        BigInt residue = base % modulus;
+        if(residue.isNegative()) residue += abs(modulus);
+        return BigInt(Operation::powmod(residue.Number(), exponent.Number(), modulus.Number()));
     }
 
-    friend BigInt operator / (const BigInt& lhs, const BigInt& rhs)
+    /**
+     *  The smallest prime greater than number; candidates are sieved by the primes below 2^16 a window at a time
+     */
+    static BigInt nextPrime(const BigInt& number)
     {
-        if(rhs.isZero()) throw "Division by zero";
-        if(lhs < rhs) return BigInt();
-        if(rhs.isUnit()) return lhs;
-        if(rhs.is2Pow()) return lhs >> (rhs.bit()-1);
+        if(number < 2) return BigInt(2);
+        return BigInt(Primality::nextPrime(number.Number()));
+    }
 
-        Sign sign = lhs.sign() == rhs.sign() ? Sign::Positive : Sign::Negative;
-        auto [result, bits] = Operation::division(lhs.Number(), rhs.Number(), Operation::Division::Mode::Div);
-        return BigInt(result, bits, sign);
+    /**
+     *  Primes in [lo, hi] in increasing order. A segmented sieve clears the range, exact up to 2^40,
+     *  beyond that its survivors go through isProbablePrime; segments are shared by threads workers,
+     *  0 uses every hardware thread. Throws when the range holds more than 2^64 numbers.
+     */
+    static std::vector<BigInt> primesInRange(const BigInt& lo, const BigInt& hi, size_t threads = 0)
+    {
+        const BigInt start = lo < 2 ? BigInt(2) : lo;
+        if(hi < start) return {};
+        const BigInt width = hi - start + 1;
+        if(width.Number().size() > 1) throw "Range is too large";
+
+        std::vector<BigInt> primes;
+        for(size_t offset : Primality::primeOffsets(start.Number(), width.Number().front(), threads))
+            primes.push_back(start + offset);
+        return primes;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator / (const BigInt& lhs, T rhs)
+    using FactorBudget = Factorization::Budget;
+    using FactorStatistics = Factorization::Statistics;
+
+    /**
+     *  Prime factorization of the magnitude in increasing order with multiplicities, empty for 0 and 1.
+     *  Trial division by the primes below 2^16, then for each composite Pollard rho (Brent), Pollard p-1
+     *  and ECM with growing bounds, its curves spread over budget.threads threads. Composites the budget
+     *  leaves unsplit are listed as they are, so entries that fail isPrime() mark an incomplete factorization.
+     */
+    static std::vector<std::pair<BigInt, size_t>> factorize(const BigInt& number, const FactorBudget& budget = {})
     {
-        return operator/(lhs, BigInt(rhs));
+        FactorStatistics statistics;
+        return factorize(number, budget, statistics);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator / (T lhs, const BigInt& rhs)
+    // as above, statistics receives the ECM curves and busy time of each of the budget's threads
+    static std::vector<std::pair<BigInt, size_t>> factorize(const BigInt& number, const FactorBudget& budget, FactorStatistics& statistics)
     {
-        return operator/(BigInt(lhs), rhs);
+        Factorization::Engine engine(budget);
+        engine.run(number.Number());
+        statistics = std::move(engine.statistics);
+
+        std::vector<BigInt> factors;
+        for(std::vector<BinaryData>* found : {&engine.primes, &engine.composites})
+            for(BinaryData& factor : *found)
+                factors.push_back(BigInt(std::move(factor)));
+        std::sort(factors.begin(), factors.end());
+
+        std::vector<std::pair<BigInt, size_t>> result;
+        for(BigInt& factor : factors)
+        {
+            if(!result.empty() && result.back().first == factor) ++result.back().second;
+            else result.emplace_back(std::move(factor), 1);
+        }
+        return result;
     }
 
-    BigInt& operator /= (const BigInt& other)
+    // F(n) with F(0) = 0 and F(1) = 1
+    static BigInt fibonacci(std::size_t nElem)
     {
-        *this = operator/(*this, other);
-        return *this;
+        return fibonacciPair(nElem).first;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    BigInt& operator /= (T other)
+    /**
+     *  (F(n), F(n + 1)) by fast doubling on (F(k - 1), F(k)) over the bits of n + 1, two squarings per bit:
+     *  F(2k - 1) = F(k)^2 + F(k - 1)^2, F(2k + 1) = 4 F(k)^2 - F(k - 1)^2 + 2 (-1)^k, F(2k) = F(2k + 1) - F(2k - 1)
+     */
+    static std::pair<BigInt, BigInt> fibonacciPair(std::size_t nElem)
     {
-        *this = operator/(*this, BigInt(toBinary(other)));
-        return *this;
+        const std::size_t last = nElem + 1;
+        BigInt previous, current(1);
+        bool odd{true};
+        for(size_t bit = LimbBits - 1 - Operation::countLeadingZeros(last); bit-- > 0;)
+        {
+            const BigInt square = current * current;
+            const BigInt previousSquare = previous * previous;
+            current = (square << 2) - previousSquare + (odd ? -2 : 2);
+            previous = square + previousSquare;
+
+            odd = (last >> bit) & 1;
+            if(odd) previous = current - previous;
+            else current -= previous;
+        }
+        return {std::move(previous), std::move(current)};
     }
 
-    friend BigInt operator % (const BigInt& lhs, const BigInt& rhs)
+    // L(n) = 2 F(n + 1) - F(n) with L(0) = 2 and L(1) = 1
+    static BigInt lucas(std::size_t nElem)
     {
-        if(lhs < rhs) return lhs;
-        Sign sign = lhs.isNegative() ? Sign::Negative : Sign::Positive;
-        auto [result, bits] = Operation::division(lhs.Number(), rhs.Number(), Operation::Division::Mode::Mod);
-        return BigInt(result, bits, sign);
+        const std::pair<BigInt, BigInt> pair = fibonacciPair(nElem);
+        return (pair.second << 1) - pair.first;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator % (const BigInt& lhs, T rhs)
+    // F(n) mod |m| in [0, |m|), every intermediate stays below the modulus; throws for m = 0 and negative n
+    static BigInt fibonacciMod(const BigInt& n, const BigInt& modulus)
     {
-        return operator%(lhs, BigInt(rhs));
+        if(modulus.isZero()) throw "Division by zero";
+        if(n.isNegative()) throw "Negative index";
+        if(modulus.isUnit()) return BigInt();
+        return BigInt(Operation::fibonacciMod(n.Number(), modulus.Number()).first);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator % (T lhs, const BigInt& rhs)
+    /**
+     *  Product of a range of BigInt as a balanced tree, 1 for an empty range.
+     *  Large products spread their subtrees over threads (0 uses every hardware thread) with work stealing.
+     */
+    template<class Range>
+    static BigInt product(const Range& factors, size_t threads = 0)
     {
-        return operator%(BigInt(lhs), rhs);
+        std::vector<LimbSpan> magnitudes;
+        bool negative{false};
+        for(const auto& factor : factors)
+        {
+            static_assert(std::is_same<std::decay_t<decltype(factor)>, BigInt>::value, "product multiplies a range of BigInt");
+            if(factor.isZero()) return BigInt();
+            magnitudes.push_back(factor.Number());
+            negative = negative != factor.isNegative();
+        }
+        return BigInt(Combinatorics::product(magnitudes, threads), negative ? Sign::Negative : Sign::Positive);
     }
 
-    BigInt& operator %= (const BigInt& other)
+    static BigInt product(std::initializer_list<BigInt> factors, size_t threads = 0)
     {
-        *this = operator%(*this, other);
-        return *this;
+        return product<std::initializer_list<BigInt>>(factors, threads);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    BigInt& operator %= (T other)
+    // n! by Luschny's prime swing, every multiplication balanced and the long products spread over threads
+    static BigInt factorial(std::size_t nElem, size_t threads = 0)
     {
-        *this = operator%(*this, BigInt(toBinary(other)));
-        return *this;
+        return BigInt(Combinatorics::factorial(nElem, threads));
     }
 
-    friend bool operator < (const BigInt& lhs, const BigInt& rhs)
+    // n!! = n (n - 2) (n - 4) ..., 1 for 0 and 1
+    static BigInt doubleFactorial(std::size_t nElem, size_t threads = 0)
     {
-        if(lhs.isPositive() && rhs.isNegative()) return false;
-        if(lhs.isNegative() && rhs.isPositive()) return true;
-        if(lhs.isNegative() && rhs.isNegative()) return Operation::greater(lhs.Number(), rhs.Number());
-        return Operation::less(lhs.Number(), rhs.Number());
+        return BigInt(Combinatorics::doubleFactorial(nElem, threads));
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator < (const BigInt& lhs, T rhs)
+    // n choose k, 0 for k > n
+    static BigInt binomial(std::size_t n, std::size_t k, size_t threads = 0)
     {
-        return operator <(lhs, BigInt(rhs));
+        return BigInt(Combinatorics::binomial(n, k, threads));
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator < (T lhs, const BigInt& rhs)
+    // n#, the product of the primes up to n
+    static BigInt primorial(std::size_t n, size_t threads = 0)
     {
-        return operator <(BigInt(lhs), rhs);
+        return BigInt(Combinatorics::primorial(n, threads));
     }
 
-    friend bool operator <= (const BigInt& lhs, const BigInt& rhs)
+    static BigInt gcd(const BigInt& u, const BigInt& v)
+    {
+        if (u == v) return u;
+        if (u.isZero()) return v;
+        if (v.isZero()) return u;
+
+        if (u.isEven())
+        {
+            if (v.isOdd()) return gcd(u/2, v);
+            else return 2 * gcd(u/2, v/2);
+        }
+        else
+        {
+            if (v.isEven()) return gcd(u, v/2);
+            if (u > v) return gcd((u - v)/2, v);
+            else return gcd((v - u)/2, u);
+        }
+    }
+
+    static BigInt lcm(const BigInt& a, const BigInt& b)
     {
-        return Operation::lessOrEqual(lhs.Number(), rhs.Number());
+        return (a*b) / gcd(a,b);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator <= (const BigInt& lhs, T rhs)
+    static BigInt isqrt(const BigInt& number)
     {
-        return operator <=(lhs, BigInt(rhs));
+        if(number.isNegative()) return BigInt();
+        if(number.Number().size() == 1)
+        {
+            const Limb value = number.Number().front();
+            Limb root = static_cast<Limb>(std::sqrt(static_cast<double>(value)));
+            while(static_cast<DoubleLimb>(root) * root > value) --root;
+            while(static_cast<DoubleLimb>(root + 1) * (root + 1) <= value) ++root;
+            return BigInt(BinaryData{root});
+        }
+
+        // the root of the upper half of the bits is close enough for one Newton step to land within one
+        const size_t shift = number.bit() / 4;
+        BigInt root = isqrt(number >> 2 * shift) << shift;
+        root = (root + number / root) >> 1;
+        while(root.square() > number) --root;
+        while((root + 1).square() <= number) ++root;
+        return root;
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator <= (T lhs, const BigInt& rhs)
+    static BigInt ilog2(const BigInt& number)
     {
-        return operator <=(BigInt(lhs), rhs);
+        return BigInt(number.bit()-1);
     }
 
-    friend bool operator > (const BigInt& lhs, const BigInt& rhs)
+    static BigInt ilog10(const BigInt& number)
     {
-        if(lhs.isPositive() && rhs.isNegative()) return true;
-        if(lhs.isNegative() && rhs.isPositive()) return false;
-        if(lhs.isNegative() && rhs.isNegative()) return Operation::less(lhs.Number(), rhs.Number());
-        return Operation::greater(lhs.Number(), rhs.Number());
+        const short base = 10;
+        if(number < base) return BigInt();
+
+        // log10(number) lies in [(bit - 1) * log10(2), bit * log10(2)), so the estimate is off by at most one
+        size_t digits = static_cast<size_t>(static_cast<double>(number.bit() - 1) * 0.30102999566398120);
+        BigInt power = pow(BigInt(base), digits);
+        while(power > number)
+        {
+            power = divmod(power, BigInt(base)).first;
+            --digits;
+        }
+        while((power *= base) <= number) ++digits;
+
+        return BigInt(digits);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator > (const BigInt& lhs, T rhs)
+    static bool isPow(BigInt number, const BigInt& pow)
     {
-        return operator >(lhs, BigInt(rhs));
+        if(number.isZero() || pow.isUnit()) return number.isUnit();
+
+        while(!number.isUnit())
+        {
+            auto [quotient, remainder] = divmod(number, pow);
+            if(!remainder.isZero()) break;
+            number = std::move(quotient);
+        }
+
+        return number.isUnit();
     }
+};
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator > (T lhs, const BigInt& rhs)
+namespace Detail
+{
+
+/**
+ *  The modular kernels ModContext runs on, over residues of a fixed number of limbs.
+ *  Only this interface appears in ModContext, so the class has the same definition in every translation unit.
+ */
+class ModField
+{
+public:
+    virtual ~ModField() = default;
+
+    virtual size_t scratchSize() const noexcept = 0;
+    virtual const Limb* one() const noexcept = 0;
+    virtual void to(Limb* result, const Limb* value, Limb* scratch) const = 0;
+    virtual void from(Limb* result, const Limb* residue, Limb* scratch) const = 0;
+    virtual void mul(Limb* result, const Limb* lhs, const Limb* rhs, Limb* scratch) const = 0;
+    virtual void sqr(Limb* result, const Limb* number, Limb* scratch) const = 0;
+    virtual void pow(Limb* result, const Limb* base, const Limb* exponent, size_t exponentSize, Limb* scratch) const = 0;
+};
+
+} // namespace Detail
+
+namespace
+{
+
+// a Montgomery or Barrett kernel behind the ModField interface
+template<class Field>
+class ModFieldOf final : public Detail::ModField
+{
+public:
+    explicit ModFieldOf(const BinaryData& modulus) :
+        m_field{modulus}
+    {}
+
+    size_t scratchSize() const noexcept override { return m_field.scratchSize(); }
+    const Limb* one() const noexcept override { return m_field.one.data(); }
+
+    void to(Limb* result, const Limb* value, Limb* scratch) const override
     {
-        return operator >(BigInt(lhs), rhs);
+        m_field.to(result, LimbSpan(value, m_field.size), scratch);
     }
 
-    friend bool operator >= (const BigInt& lhs, const BigInt& rhs)
+    void from(Limb* result, const Limb* residue, Limb* scratch) const override
     {
-        return Operation::greatOrEqual(lhs.Number(), rhs.Number());
+        const BinaryData number = m_field.from(residue, scratch);
+        std::fill(std::copy(number.begin(), number.end(), result), result + m_field.size, 0);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator >= (const BigInt& lhs, T rhs)
+    void mul(Limb* result, const Limb* lhs, const Limb* rhs, Limb* scratch) const override { m_field.mul(result, lhs, rhs, scratch); }
+    void sqr(Limb* result, const Limb* number, Limb* scratch) const override { m_field.sqr(result, number, scratch); }
+
+    void pow(Limb* result, const Limb* base, const Limb* exponent, size_t exponentSize, Limb* scratch) const override
     {
-        return operator >=(lhs, BigInt(rhs));
+        Operation::slidingWindowPow(m_field, result, base, LimbSpan(exponent, exponentSize), scratch);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator >= (T lhs, const BigInt& rhs)
+private:
+    Field m_field;
+};
+
+} // namespace
+
+/**
+ *  Arithmetic under one fixed modulus with the precomputation paid once.
+ *  Odd moduli keep values in Montgomery form (value * R mod modulus), even moduli keep them plain
+ *  and reduce by Barrett; to() and from() convert, every other member takes and returns that form
+ *  and expects reduced operands. Scratch buffers are reused between calls, so a context serves one thread at a time.
+ */
+class ModContext final
+{
+    BigInt m_modulus;
+    std::shared_ptr<const Detail::ModField> m_field;    // immutable, copies of a context share it
+    size_t m_size;
+    std::vector<Limb> m_scratch;
+    std::vector<Limb> m_lhs;
+    std::vector<Limb> m_rhs;
+    std::vector<Limb> m_result;
+
+    static std::shared_ptr<const Detail::ModField> makeField(const BinaryData& modulus)
     {
-        return operator >=(BigInt(lhs), rhs);
+        if(Operation::isZero(modulus)) throw "Division by zero";
+        if(modulus.front() & 1) return std::make_shared<ModFieldOf<Operation::Montgomery>>(modulus);
+        return std::make_shared<ModFieldOf<Operation::Barrett>>(modulus);
     }
 
-    friend bool operator == (const BigInt& lhs, const BigInt& rhs)
+    const Limb* load(std::vector<Limb>& buffer, const BigInt& value) const
     {
-        if(lhs.sign() != rhs.sign()) return false;
-        return Operation::equal(lhs.Number(), rhs.Number());
+        assert(value.isPositive() && Operation::less(value.Number(), m_modulus.Number()));
+        const BinaryData& number = value.Number();
+        std::fill(std::copy(number.begin(), number.end(), buffer.begin()), buffer.end(), 0);
+        return buffer.data();
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator == (const BigInt& lhs, T rhs)
+    BigInt result() const
     {
-        return operator ==(lhs, BigInt(rhs));
+        BinaryData number(m_result.data(), m_result.data() + m_size);
+        Operation::removeInsignificantBits(number);
+        return BigInt(std::move(number));
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator == (T lhs, const BigInt& rhs)
+public:
+    explicit ModContext(const BigInt& modulus) :
+        m_modulus{BigInt::abs(modulus)},
+        m_field{makeField(m_modulus.Number())},
+        m_size{m_modulus.Number().size()},
+        m_lhs(m_size),
+        m_rhs(m_size),
+        m_result(m_size)
     {
-        return operator ==(BigInt(lhs), rhs);
+        m_scratch.resize(m_field->scratchSize());
     }
 
-    friend bool operator != (const BigInt& lhs, const BigInt& rhs)
-    {
-        return !operator ==(lhs, rhs);
-    }
+    inline const BigInt& modulus() const { return m_modulus; }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator != (const BigInt& lhs, T rhs)
+    // any value, negative ones included, into the context form
+    BigInt to(const BigInt& value)
     {
-        return operator !=(lhs, BigInt(rhs));
+        BigInt residue = value % m_modulus;
+        if(residue.isNegative()) residue += m_modulus;
+        const Limb* number = load(m_lhs, residue);
+        m_field->to(m_result.data(), number, m_scratch.data());
+        return result();
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend bool operator != (T lhs, const BigInt& rhs)
+    BigInt from(const BigInt& value)
     {
-        return operator !=(BigInt(lhs), rhs);
+        const Limb* number = load(m_lhs, value);
+        m_field->from(m_result.data(), number, m_scratch.data());
+        return result();
     }
 
-    friend BigInt operator ^ (const BigInt& lhs, const BigInt& rhs)
+    // 1 in the context form
+    BigInt one() const
     {
-        return Transform(lhs, rhs, Operation::predicates['^']);
+        BinaryData number(m_field->one(), m_field->one() + m_size);
+        Operation::removeInsignificantBits(number);
+        return BigInt(std::move(number));
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator ^ (const BigInt& lhs, T rhs)
+    BigInt mul(const BigInt& lhs, const BigInt& rhs)
     {
-        return operator^(lhs, BigInt(rhs));
+        const Limb* left = load(m_lhs, lhs);
+        const Limb* right = load(m_rhs, rhs);
+        m_field->mul(m_result.data(), left, right, m_scratch.data());
+        return result();
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator ^ (T lhs, const BigInt& rhs)
+    BigInt sqr(const BigInt& value)
     {
-        return operator^(BigInt(lhs), rhs);
+        const Limb* number = load(m_lhs, value);
+        m_field->sqr(m_result.data(), number, m_scratch.data());
+        return result();
     }
 
-    BigInt& operator ^= (const BigInt& other)
+    BigInt add(const BigInt& lhs, const BigInt& rhs)
     {
-        *this = Transform(*this, other, Operation::predicates['^']);
-        return *this;
+        Operation::addMod(m_result.data(), load(m_lhs, lhs), load(m_rhs, rhs), m_modulus.Number().data(), m_size);
+        return result();
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    BigInt& operator ^= (T other)
+    BigInt sub(const BigInt& lhs, const BigInt& rhs)
     {
-        return operator^=(BigInt(toBinary(other)));
+        Operation::subMod(m_result.data(), load(m_lhs, lhs), load(m_rhs, rhs), m_modulus.Number().data(), m_size);
+        return result();
     }
 
-    friend BigInt operator | (const BigInt& lhs, const BigInt& rhs)
+    // a negative exponent raises the inverse
+    BigInt pow(const BigInt& value, const BigInt& exponent)
     {
-        return Transform(lhs, rhs, Operation::predicates['|']);
-    }
+        if(exponent.isZero()) return one();
+        if(exponent.isNegative()) return pow(inv(value), BigInt::abs(exponent));
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator | (const BigInt& lhs, T rhs)
-    {
-        return operator|(lhs, BigInt(rhs));
+        const Limb* number = load(m_lhs, value);
+        m_field->pow(m_result.data(), number, exponent.Number().data(), exponent.Number().size(), m_scratch.data());
+        return result();
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator | (T lhs, const BigInt& rhs)
+    // throws when the value shares a factor with the modulus
+    BigInt inv(const BigInt& value)
     {
-        return operator|(BigInt(lhs), rhs);
-    }
+        // extended Euclid, only the coefficient of the value is tracked
+        BigInt remainder = m_modulus, next = from(value);
+        BigInt coefficient, nextCoefficient(1);
+        while(!next.isZero())
+        {
+            std::pair<BigInt, BigInt> step = BigInt::divmod(remainder, next);
+            remainder = std::move(next);
+            next = std::move(step.second);
+            BigInt updated = coefficient - step.first * nextCoefficient;
+            coefficient = std::move(nextCoefficient);
+            nextCoefficient = std::move(updated);
+        }
 
-    BigInt& operator |= (const BigInt& other)
-    {
-        *this = Transform(*this, other, Operation::predicates['|']);
-        return *this;
+        if(!remainder.isUnit() && !m_modulus.isUnit()) throw "Not invertible";
+        return to(coefficient);
     }
+};
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    BigInt& operator |= (T other)
+/**
+ *  Appends values to a binary archive (see Converter::Record) on a stream or a file descriptor.
+ *  Output is buffered; flush() or destruction pushes it out. The descriptor is not closed.
+ */
+class BigIntWriter final
+{
+    static constexpr const size_t BufferSize = 1 << 16;
+
+    std::ostream* m_stream{nullptr};
+    int m_fd{-1};
+    std::vector<uint8_t> m_buffer;
+    size_t m_offset{0};
+    size_t m_count{0};
+
+    void drain(const uint8_t* data, size_t size)
     {
-        return operator|=(BigInt(toBinary(other)));
+        if(m_stream != nullptr)
+        {
+            if(!m_stream->write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size))) throw "Write failed";
+            return;
+        }
+
+        while(size != 0)
+        {
+            const ssize_t written = ::write(m_fd, data, size);
+            if(written < 0 && errno == EINTR) continue;
+            if(written <= 0) throw "Write failed";
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
     }
 
-    friend BigInt operator & (const BigInt& lhs, const BigInt& rhs)
+    void put(const uint8_t* data, size_t size)
     {
-        return Transform(lhs, rhs, Operation::predicates['&']);
+        m_offset += size;
+        if(m_buffer.size() + size > BufferSize)
+        {
+            drain(m_buffer.data(), m_buffer.size());
+            m_buffer.clear();
+            // large payloads skip the buffer
+            if(size >= BufferSize) return drain(data, size);
+        }
+        m_buffer.insert(m_buffer.end(), data, data + size);
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator & (const BigInt& lhs, T rhs)
+    void start()
     {
-        return operator&(lhs, BigInt(rhs));
+        m_buffer.reserve(BufferSize);
+        uint8_t header[Converter::Record::HeaderSize];
+        Converter::Record::Header(header);
+        put(header, sizeof(header));
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    friend BigInt operator & (T lhs, const BigInt& rhs)
+public:
+    explicit BigIntWriter(std::ostream& stream) :
+        m_stream{&stream}
     {
-        return operator&(BigInt(lhs), rhs);
+        start();
     }
 
-    BigInt& operator &= (const BigInt& other)
+    explicit BigIntWriter(int fd) :
+        m_fd{fd}
     {
-        *this = Transform(*this, other, Operation::predicates['&']);
-        return *this;
+        start();
     }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>>>
-    BigInt& operator &= (T other)
+    BigIntWriter(const BigIntWriter&) = delete;
+    BigIntWriter& operator = (const BigIntWriter&) = delete;
+
+    ~BigIntWriter()
     {
-        return operator&=(BigInt(toBinary(other)));
+        try { flush(); } catch(...) {}
     }
 
-    friend BigInt operator ~(const BigInt& number)
+    BigIntWriter& write(const BigInt& value)
     {
-        if(number.isZero())
-            return BigInt(BinaryData{1}, 1, Sign::Negative);
+        const BinaryData& number = value.Number();
 
-        if(number.isPositive())
+        uint8_t tag[Converter::Record::MaxVarintSize + LimbBytes];
+        size_t size = Converter::Record::EncodeVarint(Converter::Record::Tag(number, value.sign()), tag);
+        const size_t padding = Converter::Record::Padding(m_offset + size);
+        std::fill(tag + size, tag + size + padding, 0);
+        put(tag, size + padding);
+
+        if constexpr(LittleEndianHost)
         {
-            BinaryData data = number.Number();
-            size_t bits = number.count();
-            Operation::Increment(data, bits);
-            return BigInt(data, bits, Sign::Negative);
+            put(reinterpret_cast<const uint8_t*>(number.data()), number.size() * LimbBytes);
         }
         else
         {
-            BinaryData data = number.Number();
-            size_t bits = number.count();
-            Operation::Decrement(data, bits);
-            return BigInt(data, bits, Sign::Positive);
+            for(const Limb& limb : number)
+            {
+                const Limb swapped = __builtin_bswap64(limb);
+                put(reinterpret_cast<const uint8_t*>(&swapped), LimbBytes);
+            }
         }
 
-        return BigInt();
+        ++m_count;
+        return *this;
     }
 
-    friend BigInt operator -(const BigInt& number)
-    {
-        return BigInt(number.Number(), number.count(), number.isPositive() ? Sign::Negative : Sign::Negative);
-    }
+    BigIntWriter& operator << (const BigInt& value) { return write(value); }
 
-    BigInt operator !()
+    void flush()
     {
-        return isZero() ? BigInt(BinaryData{1}, 1, Sign::Positive) : BigInt();
+        drain(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+        if(m_stream != nullptr && !m_stream->flush()) throw "Write failed";
     }
 
-    friend BigInt operator << (const BigInt& lhs, const size_t offset)
-    {
-        BinaryData newResult = lhs.Number();
-        Operation::leftShift(newResult, offset);
-        return BigInt(newResult, lhs.count(), lhs.sign());
-    }
+    // values written so far
+    inline size_t count() const { return m_count; }
+};
 
-    BigInt& operator <<= (const size_t offset)
+/**
+ *  Reads the values of a binary archive one at a time from a stream or a file descriptor,
+ *  only the current value and a fixed-size buffer are held in memory.
+ *  Throws on a bad header or a truncated or corrupted record.
+ */
+class BigIntReader final
+{
+    static constexpr const size_t BufferSize = 1 << 16;
+
+    std::istream* m_stream{nullptr};
+    int m_fd{-1};
+    std::vector<uint8_t> m_buffer;
+    size_t m_begin{0};
+    size_t m_end{0};
+    size_t m_offset{0};
+
+    size_t fetch(uint8_t* data, size_t size)
     {
-        Operation::leftShift(m_state.number, offset);
-        return *this;
+        if(m_stream != nullptr)
+        {
+            m_stream->read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+            if(m_stream->bad()) throw "Read failed";
+            return static_cast<size_t>(m_stream->gcount());
+        }
+
+        for(;;)
+        {
+            const ssize_t got = ::read(m_fd, data, size);
+            if(got < 0 && errno == EINTR) continue;
+            if(got < 0) throw "Read failed";
+            return static_cast<size_t>(got);
+        }
     }
 
-    friend BigInt operator >> (const BigInt& lhs, const size_t offset)
+    // buffers up to size bytes, fewer only at the end of the input
+    size_t fill(size_t size)
     {
-        BinaryData newResult = lhs.Number();
-        size_t units = lhs.count();
-        Operation::rightShift(newResult, units, offset);
-        return BigInt(newResult, units, lhs.sign());
+        if(m_end - m_begin >= size) return size;
+
+        std::copy(m_buffer.begin() + m_begin, m_buffer.begin() + m_end, m_buffer.begin());
+        m_end -= m_begin;
+        m_begin = 0;
+        while(m_end < size)
+        {
+            const size_t got = fetch(m_buffer.data() + m_end, m_buffer.size() - m_end);
+            if(got == 0) break;
+            m_end += got;
+        }
+        return std::min(size, m_end);
     }
 
-    BigInt& operator >>= (const size_t offset)
+    void take(uint8_t* data, size_t size)
     {
-        Operation::rightShift(m_state.number, m_state.bitSet, offset);
-        return *this;
+        m_offset += size;
+        const size_t buffered = std::min(size, m_end - m_begin);
+        std::copy(m_buffer.begin() + m_begin, m_buffer.begin() + m_begin + buffered, data);
+        m_begin += buffered;
+        data += buffered;
+        size -= buffered;
+
+        // the rest of a large value goes straight into its limbs
+        while(size != 0)
+        {
+            const size_t got = fetch(data, size);
+            if(got == 0) throw "Truncated record";
+            data += got;
+            size -= got;
+        }
     }
 
-    friend std::ostream& operator << (std::ostream& os, const BigInt& number)
+    void start()
     {
-        os << number.toDecimal();
-        return os;
+        m_buffer.resize(BufferSize);
+        uint8_t header[Converter::Record::HeaderSize];
+        if(fill(sizeof(header)) != sizeof(header)) throw "Invalid format";
+        take(header, sizeof(header));
+        Converter::Record::CheckHeader(header);
     }
 
-    friend std::istream& operator >> (std::istream& is, BigInt& number)
+public:
+    explicit BigIntReader(std::istream& stream) :
+        m_stream{&stream}
     {
-        std::string str;
-        is >> str;
-        number = str;
-        return is;
+        start();
     }
 
-    BigInt& operator++()
+    explicit BigIntReader(int fd) :
+        m_fd{fd}
     {
-           isNegative() ? Operation::Decrement(m_state.number, m_state.bitSet)
-                      : Operation::Increment(m_state.number, m_state.bitSet);
-        return *this;
+        start();
     }
 
-    BigInt& operator--()
-    {
-        if(isZero())
-            *this = BigInt(BinaryData{1}, 1, Sign::Negative);
-        else if(isPositive())
-            Operation::Decrement(m_state.number, m_state.bitSet);
-        else if(isNegative())
-            Operation::Increment(m_state.number, m_state.bitSet);
+    BigIntReader(const BigIntReader&) = delete;
+    BigIntReader& operator = (const BigIntReader&) = delete;
 
-        return *this;
-    }
+    /**
+     *  Reads the next value
+     *  @return false at the end of the archive
+     */
+    bool read(BigInt& value)
+    {
+        const size_t available = fill(Converter::Record::MaxVarintSize);
+        if(available == 0) return false;
+
+        uint64_t tag{0};
+        const size_t tagSize = Converter::Record::DecodeVarint(m_buffer.data() + m_begin, available, tag);
+        if(tagSize == 0) throw "Truncated record";
+        m_begin += tagSize;
+        m_offset += tagSize;
+
+        const size_t padding = Converter::Record::Padding(m_offset);
+        if(fill(padding) != padding) throw "Truncated record";
+        m_begin += padding;
+        m_offset += padding;
+
+        // the count is not trusted: storage grows only as limbs arrive, so a corrupted one ends as a truncated record
+        const size_t size = Converter::Record::LimbCount(tag);
+        BinaryData number;
+        for(size_t done{0}; done < size;)
+        {
+            const size_t chunk = std::min(size - done, BufferSize / LimbBytes);
+            if(done + chunk > number.capacity())
+                number.reserve(std::min(size, std::max(done + chunk, 2 * number.capacity())));
+            number.resize(done + chunk);
+            take(reinterpret_cast<uint8_t*>(number.data() + done), chunk * LimbBytes);
+            done += chunk;
+        }
+        if constexpr(!LittleEndianHost)
+        {
+            for(Limb& limb : number)
+                limb = __builtin_bswap64(limb);
+        }
 
-    BigInt operator++(int)
-    {
-        auto tmp = *this;
-        isNegative() ? Operation::Decrement(m_state.number, m_state.bitSet)
-                     : Operation::Increment(m_state.number, m_state.bitSet);
-        return tmp;
+        const Sign sign = Converter::Record::SignOf(tag);
+        Converter::Record::CheckLimbs(number.data(), size, sign);
+        value = BigInt(std::move(number), sign);
+        return true;
     }
 
-    BigInt operator--(int)
+    class iterator
     {
-        auto tmp = *this;
-        if(isZero())
-            *this = BigInt(BinaryData{1}, 1, Sign::Negative);
-        else if(isPositive())
-            Operation::Decrement(m_state.number, m_state.bitSet);
-        else if(isNegative())
-            Operation::Increment(m_state.number, m_state.bitSet);
+        BigIntReader* m_reader{nullptr};
+        BigInt m_value;
 
-        return tmp;
-    }
+        void next()
+        {
+            if(!m_reader->read(m_value)) m_reader = nullptr;
+        }
 
-    template<class T, class = typename std::enable_if_t<is_integer<T>()>>
-    explicit operator T()
-    {
-        if(isNegative() && is_unsigned<T>()) return 0;
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = BigInt;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const BigInt*;
+        using reference = const BigInt&;
 
-        const short byteLenght = 8;
-        const unsigned short lenght = sizeof(T) * byteLenght;
-        const bool condition = (isNegative() ? is2Pow() : count() == bit());
+        iterator() = default;
+        explicit iterator(BigIntReader* reader) :
+            m_reader{reader}
+        {
+            next();
+        }
 
-        if(lenght > bit() || (lenght == bit() && condition ) )
-            return isNegative() ? -1*Converter::FromBinary::toInt<T>(Number())
-                                : Converter::FromBinary::toInt<T>(Number());
+        reference operator*() const { return m_value; }
+        pointer operator->() const { return &m_value; }
+        iterator& operator++() { next(); return *this; }
+        bool operator == (const iterator& other) const { return m_reader == other.m_reader; }
+        bool operator != (const iterator& other) const { return !(*this == other); }
+    };
 
-        return 0;
-    }
+    // single pass, begin() starts reading at the current record
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+};
 
-    static BigInt abs(const BigInt& number)
-    {
-        return number.isNegative() ? BigInt(number.Number(), number.bit(), Sign::Positive)
-                                   : number;
-    }
+/**
+ *  Read-only value over normalized limbs owned elsewhere, typically a record of a mapped archive.
+ *  Nothing is copied, so the limbs must outlive the view.
+ */
+class BigIntView final
+{
+    static constexpr const Limb m_zero = 0;
 
-    static BigInt pow(const BigInt& number, size_t pow)
+    // plain members, the header's own span and sign types have internal linkage
+    const Limb* m_data;
+    size_t m_size;
+    bool m_negative;
+
+    inline LimbSpan number() const noexcept { return LimbSpan(m_data, m_size); }
+
+    // the operators below are not members, so they reach the private BigInt constructor through here
+    static BigInt make(BinaryData number, Sign sign) { return BigInt(std::move(number), sign); }
+
+public:
+    BigIntView() noexcept :
+        m_data{&m_zero},
+        m_size{1},
+        m_negative{false}
+    {}
+
+    BigIntView(const Limb* limbs, size_t size, Sign sign = Sign::Positive) noexcept :
+        m_data{limbs},
+        m_size{size},
+        m_negative{sign == Sign::Negative}
     {
-        if(pow == 0) return BigInt(1);
-        if(pow == 1) return number;
+        assert(size > 0 && (size == 1 || limbs[size - 1] != 0));
+        if(isZero()) m_negative = false;
+    }
 
-        static auto countBits = [](const size_t& number) -> size_t
-        {
-            return static_cast<size_t>(log2(number));
-        };
+    BigIntView(const BigInt& value) noexcept :
+        m_data{value.Number().data()},
+        m_size{value.Number().size()},
+        m_negative{value.isNegative()}
+    {}
 
-        BigInt result(1);
-        BigInt tempResult = number;
+    inline const Limb* data() const { return m_data; }
+    inline size_t size() const { return m_size; }
+    inline size_t count() const { return Operation::popCount(number()); }
+    inline size_t bit() const { return Operation::bitLength(number()); }
+    inline Sign sign() const { return m_negative ? Sign::Negative : Sign::Positive; }
+    inline bool isPositive() const { return !m_negative; }
+    inline bool isNegative() const { return !isPositive(); }
+    inline bool isEven() const { return (m_data[0] & 1) == 0; }
+    inline bool isOdd() const { return !isEven(); }
+    inline bool isZero() const { return Operation::isZero(number()); }
+    inline bool isUnit() const { return m_size == 1 && m_data[0] == 1; }
 
-        while(pow)
-        {
-            if(pow == 1)
-            {
-                result *= number;
-                break;
-            }
-            size_t count = countBits(pow);
-            for(size_t i{0}; i < count; ++i)
-                tempResult *= tempResult;
+    inline std::string toHex(bool uppercase = true, bool prefix = false) const
+    {
+        return Converter::FromBinary::ToHex(number(), sign(), uppercase, prefix);
+    }
 
-            pow -= 1 << count;
-            result *= tempResult;
-            tempResult = number;
-        }
+    // an owning copy
+    BigInt toBigInt() const
+    {
+        return make(BinaryData(m_data, m_data + m_size), sign());
+    }
 
-        return result;
+    /**
+     *  @return -1 if lhs < rhs, 0 if lhs == rhs, 1 if lhs > rhs
+     */
+    static int compare(BigIntView lhs, BigIntView rhs) noexcept
+    {
+        if(lhs.m_negative != rhs.m_negative) return lhs.isNegative() ? -1 : 1;
+        const int order = Operation::compare(lhs.number(), rhs.number());
+        return lhs.isNegative() ? -order : order;
     }
 
-    static std::vector<BigInt> factorize(BigInt number)
+    friend bool operator == (BigIntView lhs, BigIntView rhs) { return compare(lhs, rhs) == 0; }
+    friend bool operator != (BigIntView lhs, BigIntView rhs) { return compare(lhs, rhs) != 0; }
+    friend bool operator < (BigIntView lhs, BigIntView rhs) { return compare(lhs, rhs) < 0; }
+    friend bool operator <= (BigIntView lhs, BigIntView rhs) { return compare(lhs, rhs) <= 0; }
+    friend bool operator > (BigIntView lhs, BigIntView rhs) { return compare(lhs, rhs) > 0; }
+    friend bool operator >= (BigIntView lhs, BigIntView rhs) { return compare(lhs, rhs) >= 0; }
+
+    friend BigInt operator + (const BigInt& lhs, BigIntView rhs)
     {
-        std::vector<BigInt> factors;
-        BigInt divisor(2);
-        while(divisor*divisor <= number)
-        {
-            if((number%divisor).isZero())
-            {
-                factors.push_back(divisor);
-                number /= divisor;
-            }
-            else if(divisor == 2) divisor = BigInt(3);
-            else divisor += 2;
-        }
+        const LimbSpan number = lhs.Number();
+        if(lhs.sign() == rhs.sign())
+            return make(Operation::addition(number, rhs.number()), lhs.sign());
 
-        factors.push_back(number);
+        if(Operation::less(number, rhs.number()))
+            return make(Operation::subtraction(rhs.number(), number), rhs.sign());
 
-        return factors;
+        return make(Operation::subtraction(number, rhs.number()), lhs.sign());
     }
 
-    static BigInt fibonacci(std::size_t nElem)
+    friend BigInt operator * (const BigInt& lhs, BigIntView rhs)
     {
-        BigInt a(1), b(1), c(1), rd(1);
-        BigInt ta, tb, rc, tc, d;
+        if(lhs.isZero() || rhs.isZero()) return BigInt();
+        const Sign sign = lhs.sign() == rhs.sign() ? Sign::Positive : Sign::Negative;
 
-        while(nElem)
-        {
-            if(nElem&1) // isOdd
-            {
-                tc = rc;
-                rc = rc*a + rd*c;
-                rd = tc*b + rd*d;
-            }
+        const BinaryData& number = lhs.Number();
+        BinaryData result(number.size() + rhs.size());
+        Operation::multiplication(result.data(), number.data(), number.size(), rhs.data(), rhs.size());
+        Operation::removeInsignificantBits(result);
+        return make(std::move(result), sign);
+    }
 
-            ta = a;
-            tb = b;
-            tc = c;
-            a = a*a + b*c;
-            b = ta*b + b*d;
-            c = c*ta + d*c;
-            d = tc*tb+ d*d;
+    // the remainder takes the sign of the dividend, as for BigInt
+    friend BigInt operator % (const BigInt& lhs, BigIntView rhs)
+    {
+        if(rhs.isZero()) throw "Division by zero";
+        if(Operation::less(lhs.Number(), rhs.number())) return lhs;
+        return make(Operation::division(lhs.Number(), rhs.number()).remainder, lhs.sign());
+    }
 
-            nElem /= 2;
-        }
+    friend BigInt& operator += (BigInt& lhs, BigIntView rhs) { return lhs = lhs + rhs; }
+    friend BigInt& operator *= (BigInt& lhs, BigIntView rhs) { return lhs = lhs * rhs; }
+    friend BigInt& operator %= (BigInt& lhs, BigIntView rhs) { return lhs = lhs % rhs; }
+};
 
-        return rc;
-    }
+/**
+ *  Maps a binary archive read-only and hands out its records as views over the mapping,
+ *  so a scan never allocates. Views stay valid while the reader lives.
+ *  The archive keeps its limbs aligned and little endian, which is what a little-endian host needs.
+ */
+class BigIntMappedReader final
+{
+    const uint8_t* m_data{nullptr};
+    size_t m_size{0};
+    size_t m_offset{0};
 
-    static BigInt factorial(std::size_t nElem)
+    void map(int fd)
     {
-        if(nElem == 1 || nElem == 0)
-            return BigInt(1);
+        if constexpr(!LittleEndianHost) throw "Unsupported host";
 
-        bool handleOdd {false};
-        size_t uptoNumber {nElem};
+        struct stat status;
+        if(::fstat(fd, &status) != 0) throw "Read failed";
+        m_size = static_cast<size_t>(status.st_size);
+        if(m_size < Converter::Record::HeaderSize) throw "Invalid format";
 
-        if((nElem & 1) == 1)
+        void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) throw "Read failed";
+        ::madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const uint8_t*>(data);
+
+        try
         {
-            --uptoNumber;
-            handleOdd = true;
+            Converter::Record::CheckHeader(m_data);
         }
-
-        BigInt nextSum(uptoNumber);
-        BigInt nextMulti(uptoNumber);
-        BigInt factorial(1);
-
-        while(nextSum >= 2)
+        catch(...)
         {
-            factorial *= nextMulti;
-            nextSum -= 2;
-            nextMulti += nextSum;
+            ::munmap(data, m_size);
+            throw;
         }
-
-        if (handleOdd) factorial *= nElem;
-
-        return factorial;
+        m_offset = Converter::Record::HeaderSize;
     }
 
-    static BigInt gcd(const BigInt& u, const BigInt& v)
+public:
+    explicit BigIntMappedReader(const std::string& path)
     {
-        if (u == v) return u;
-        if (u.isZero()) return v;
-        if (v.isZero()) return u;
-
-        if (u.isEven())
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0) throw "Read failed";
+        try
         {
-            if (v.isOdd()) return gcd(u/2, v);
-            else return 2 * gcd(u/2, v/2);
+            map(fd);
         }
-        else
+        catch(...)
         {
-            if (v.isEven()) return gcd(u, v/2);
-            if (u > v) return gcd((u - v)/2, v);
-            else return gcd((v - u)/2, u);
+            ::close(fd);
+            throw;
         }
+        ::close(fd);
     }
 
-    static BigInt lcm(const BigInt& a, const BigInt& b)
+    // the descriptor may be closed once the reader is built
+    explicit BigIntMappedReader(int fd)
     {
-        return (a*b) / gcd(a,b);
+        map(fd);
     }
 
-    static BigInt isqrt(BigInt number)
+    BigIntMappedReader(const BigIntMappedReader&) = delete;
+    BigIntMappedReader& operator = (const BigIntMappedReader&) = delete;
+
+    ~BigIntMappedReader()
     {
-        if(number.isNegative() || number.isZero() || number.isUnit()) return BigInt();
-        BigInt result;
-        const short roundingToLowPow2 = 2;
-        BigInt bit = 1 << (number.bit()-roundingToLowPow2);
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
 
-        while (!bit.isZero())
-        {
-            if(auto add = result + bit; number >= add)
-            {
-                number -= add;
-                result = (result>>1) + bit;
-            }
-            else result >>= 1;
+    /**
+     *  Points view at the next record
+     *  @return false at the end of the archive
+     */
+    bool read(BigIntView& view)
+    {
+        if(m_offset == m_size) return false;
 
-            bit >>= 2;
-        }
+        uint64_t tag{0};
+        const size_t tagSize = Converter::Record::DecodeVarint(m_data + m_offset, m_size - m_offset, tag);
+        if(tagSize == 0) throw "Truncated record";
 
-        return result;
-    }
+        size_t offset = m_offset + tagSize;
+        offset += Converter::Record::Padding(offset);
+        const size_t size = Converter::Record::LimbCount(tag);
+        if(offset > m_size || size > (m_size - offset) / LimbBytes) throw "Truncated record";
 
-    static BigInt ilog2(const BigInt& number)
-    {
-        return BigInt(number.bit()-1);
+        const Limb* limbs = reinterpret_cast<const Limb*>(m_data + offset);
+        const Sign sign = Converter::Record::SignOf(tag);
+        Converter::Record::CheckLimbs(limbs, size, sign);
+        view = BigIntView(limbs, size, sign);
+        m_offset = offset + size * LimbBytes;
+        return true;
     }
 
-    static BigInt ilog10(const BigInt& number)
-    {
-        const short base = 10;
-        if(number < base) return BigInt();
-        return number.toDecimal().size()-1;
-    }
+    // back to the first record
+    void rewind() { m_offset = Converter::Record::HeaderSize; }
 
-    static bool isPow(BigInt number, const BigInt& pow)
+    class iterator
     {
-        while(!number.isUnit())
+        BigIntMappedReader* m_reader{nullptr};
+        BigIntView m_value;
+
+        void next()
         {
-            if(!((number % pow).isZero())) break;
-            number /= pow;
+            if(!m_reader->read(m_value)) m_reader = nullptr;
         }
 
-        return number.isUnit();
-    }
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = BigIntView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const BigIntView*;
+        using reference = const BigIntView&;
+
+        iterator() = default;
+        explicit iterator(BigIntMappedReader* reader) :
+            m_reader{reader}
+        {
+            next();
+        }
+
+        reference operator*() const { return m_value; }
+        pointer operator->() const { return &m_value; }
+        iterator& operator++() { next(); return *this; }
+        bool operator == (const iterator& other) const { return m_reader == other.m_reader; }
+        bool operator != (const iterator& other) const { return !(*this == other); }
+    };
+
+    // single pass from the current record, rewind() starts over
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
 };
 
 } // namespace BigInt
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "BigInt.hpp"
+
+namespace
+{
+
+int failures{0};
+
+void check(bool condition, const char* expression)
+{
+    if(condition) return;
+    std::cerr << "failed: " << expression << std::endl;
+    ++failures;
+}
+
+#define CHECK(expression) check((expression), #expression)
+
+void isPow()
+{
+    using BigInt::BigInt;
+
+    // non-powers whose quotient by the base is 1
+    CHECK(!BigInt::isPow(BigInt(3), BigInt(2)));
+    CHECK(!BigInt::isPow(BigInt(5), BigInt(4)));
+    CHECK(!BigInt::isPow(BigInt(6), BigInt(4)));
+    CHECK(!BigInt::isPow(BigInt(7), BigInt(4)));
+    CHECK(!BigInt::isPow(BigInt(17), BigInt(16)));
+    CHECK(!BigInt::isPow(BigInt(12), BigInt(2)));
+
+    CHECK(BigInt::isPow(BigInt(1), BigInt(2)));
+    CHECK(BigInt::isPow(BigInt(16), BigInt(4)));
+    CHECK(BigInt::isPow(BigInt::pow(BigInt(3), 80), BigInt(3)));
+    CHECK(!BigInt::isPow(BigInt::pow(BigInt(3), 80) + 1, BigInt(3)));
+}
+
+// a random nonzero operand of limbs limbs, some all ones or sparse to stress the carries
+BigInt::BigInt randomNumber(std::mt19937_64& generator, size_t limbs)
+{
+    using BigInt::BigInt;
+
+    const int kind = static_cast<int>(generator() % 4);
+    BigInt number;
+    for(size_t i{0}; i < limbs; ++i)
+    {
+        const uint64_t limb = kind == 0 ? ~uint64_t{0} : kind == 1 ? (generator() % 4 == 0 ? 0 : ~uint64_t{0}) : generator();
+        number <<= 64;
+        number += BigInt(limb >> 1) * 2 + BigInt(limb & 1);
+    }
+    if(number.isZero()) number = BigInt(1);
+    if(generator() % 2) number = -number;
+    return number;
+}
+
+// products and quotients with every tier forced on from the smallest sizes agree with schoolbook and long division
+void tiers()
+{
+    using BigInt::BigInt;
+
+    std::mt19937_64 generator(2024);
+    std::vector<BigInt> operands;
+    for(size_t i{0}; i < 300; ++i)
+        operands.push_back(randomNumber(generator, 1 + generator() % (i % 10 == 0 ? 300 : 40)));
+
+    // schoolbook products and long division give the expected values
+    const size_t off = 1 << 30;
+    const BigInt::Tuning defaults = BigInt::tuning();
+    BigInt::Tuning& tuning = BigInt::tuning();
+    tuning = {off, off, off, off, off, off};
+
+    struct Case
+    {
+        BigInt product;
+        BigInt square;
+        std::pair<BigInt, BigInt> division;
+    };
+    std::vector<Case> expected;
+    for(size_t i{0}; i < operands.size(); ++i)
+    {
+        const BigInt& lhs = operands[i];
+        const BigInt& rhs = operands[(i * 7 + 1) % operands.size()];
+        expected.push_back({lhs * rhs, lhs * lhs, BigInt::divmod(lhs * rhs + lhs, rhs)});
+    }
+
+    // each configuration leaves one tier in charge from the smallest sizes it accepts, 0 and 1 included
+    const std::vector<BigInt::Tuning> configurations
+    {
+        {0, 0, off, off, 0, off},   // Karatsuba and Burnikel-Ziegler, thresholds below their minimums
+        {1, 1, off, off, 1, off},
+        {2, 2, off, off, 2, off},
+        {3, 3, off, off, 3, off},
+        {2, 2, 3, off, 2, off},     // Toom-3
+        {2, 2, 3, 4, 2, off},       // NTT
+        {2, 2, 3, 4, 2, 2},         // Newton division
+    };
+    for(const BigInt::Tuning& configuration : configurations)
+    {
+        tuning = configuration;
+        for(size_t i{0}; i < operands.size(); ++i)
+        {
+            const BigInt& lhs = operands[i];
+            const BigInt& rhs = operands[(i * 7 + 1) % operands.size()];
+            CHECK(lhs * rhs == expected[i].product);
+            CHECK(lhs * lhs == expected[i].square);
+            CHECK(BigInt::divmod(lhs * rhs + lhs, rhs) == expected[i].division);
+        }
+    }
+
+    tuning = defaults;
+}
+
+} // namespace
+
+int main()
+{
+    isPow();
+    tiers();
+    return failures == 0 ? 0 : 1;
+}